@@ -0,0 +1,228 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "analyzer.h"
+#include "arena.h"
+#include "analysis.h"
+#include "chroma.h"
+#include "onset.h"
+#include "pitch.h"
+
+// The analysis and its arena come in one allocation.
+struct analysis_block
+{
+    struct analysis an;
+    struct arena arena;
+    struct spectrum_analyzer sa;
+    struct onset_detector od;
+    struct chroma_analyzer ca;
+    struct pitch_detector pd;
+};
+
+struct analysis *
+analysis_create (const struct analysis_config *config)
+{
+    const struct analysis_config *c = config;
+
+    struct analysis_block *block = calloc(1, sizeof *block);
+    if (!block)
+        return NULL;
+
+    struct analysis *an = &block->an;
+    an->config = *c;
+    an->arena = &block->arena;
+
+    int ret = arena_init(an->arena,
+                         sa_footprint(c->window_size, c->num_points)
+                         + (c->onsets ? onset_footprint(c->window_size, c->sample_rate) : 0)
+                         + (c->chroma ? chroma_footprint(c->window_size, c->sample_rate) : 0)
+                         + (c->pitch ? pitch_footprint(c->window_size) : 0),
+                         c->huge_pages);
+
+    if (ret == 0)
+    {
+        an->sa = &block->sa;
+        ret = sa_init(an->sa, an->arena, c->window_size, c->num_points, c->sample_rate);
+    }
+    if (ret == 0 && c->onsets)
+    {
+        an->od = &block->od;
+        ret = onset_init(an->od, an->arena, c->window_size, c->sample_rate);
+    }
+    if (ret == 0 && c->chroma)
+    {
+        an->ca = &block->ca;
+        ret = chroma_init(an->ca, an->arena, c->window_size, c->sample_rate);
+    }
+    if (ret == 0 && c->pitch)
+    {
+        an->pd = &block->pd;
+        ret = pitch_init(an->pd, an->arena, c->window_size, c->sample_rate);
+    }
+
+    if (ret != 0)
+    {
+        analysis_destroy(an);
+        return NULL;
+    }
+
+    return an;
+}
+
+void
+analysis_destroy (struct analysis *an)
+{
+    arena_deinit(an->arena);
+    free(an);
+}
+
+static void *
+analysis_builder_run (void *_ab)
+{
+    struct analysis_builder *ab = _ab;
+
+    pthread_mutex_lock(&ab->lock);
+
+    for (;;)
+    {
+        while (!ab->requested && !ab->retired && !ab->quit)
+            pthread_cond_wait(&ab->wake, &ab->lock);
+
+        if (ab->quit)
+            break;
+
+        // Unmapping big arenas takes a while too; not on the render thread.
+        struct analysis *retired = ab->retired;
+        ab->retired = NULL;
+
+        struct analysis_config config = ab->request;
+        const bool requested = ab->requested;
+        ab->requested = false;
+
+        pthread_mutex_unlock(&ab->lock);
+
+        while (retired)
+        {
+            struct analysis *next = retired->next;
+            analysis_destroy(retired);
+            retired = next;
+        }
+
+        if (requested)
+        {
+            struct analysis *an = analysis_create(&config);
+
+            if (an)
+            {
+                // One that was never taken has been overtaken by this one.
+                struct analysis *stale = atomic_exchange_explicit(&ab->ready, an, memory_order_acq_rel);
+                if (stale)
+                    analysis_destroy(stale);
+            } else
+                fprintf(stderr, "Couldn't set up a %d-sample analysis :(\n", config.window_size);
+        }
+
+        pthread_mutex_lock(&ab->lock);
+    }
+
+    pthread_mutex_unlock(&ab->lock);
+
+    return NULL;
+}
+
+int
+analysis_builder_start (struct analysis_builder *ab)
+{
+    ab->requested = false;
+    ab->quit = false;
+    ab->retired = NULL;
+    atomic_init(&ab->ready, NULL);
+
+    if (pthread_mutex_init(&ab->lock, NULL) != 0)
+        return -1;
+
+    if (pthread_cond_init(&ab->wake, NULL) != 0)
+    {
+        pthread_mutex_destroy(&ab->lock);
+        return -1;
+    }
+
+    if (pthread_create(&ab->thread, NULL, analysis_builder_run, ab) != 0)
+    {
+        pthread_cond_destroy(&ab->wake);
+        pthread_mutex_destroy(&ab->lock);
+        return -1;
+    }
+
+    return 0;
+}
+
+void
+analysis_builder_request (struct analysis_builder *ab, const struct analysis_config *config)
+{
+    pthread_mutex_lock(&ab->lock);
+    ab->request = *config;
+    ab->requested = true;
+    pthread_cond_signal(&ab->wake);
+    pthread_mutex_unlock(&ab->lock);
+}
+
+struct analysis *
+analysis_builder_take (struct analysis_builder *ab)
+{
+    // Checked first, so that the common case doesn't write to the shared line.
+    if (!atomic_load_explicit(&ab->ready, memory_order_relaxed))
+        return NULL;
+
+    return atomic_exchange_explicit(&ab->ready, NULL, memory_order_acquire);
+}
+
+void
+analysis_builder_retire (struct analysis_builder *ab, struct analysis *an)
+{
+    pthread_mutex_lock(&ab->lock);
+    an->next = ab->retired;
+    ab->retired = an;
+    pthread_cond_signal(&ab->wake);
+    pthread_mutex_unlock(&ab->lock);
+}
+
+void
+analysis_builder_stop (struct analysis_builder *ab)
+{
+    pthread_mutex_lock(&ab->lock);
+    ab->quit = true;
+    pthread_cond_signal(&ab->wake);
+    pthread_mutex_unlock(&ab->lock);
+
+    pthread_join(ab->thread, NULL);
+
+    for (struct analysis *an = ab->retired, *next; an; an = next)
+    {
+        next = an->next;
+        analysis_destroy(an);
+    }
+
+    struct analysis *ready = atomic_load_explicit(&ab->ready, memory_order_acquire);
+    if (ready)
+        analysis_destroy(ready);
+
+    pthread_cond_destroy(&ab->wake);
+    pthread_mutex_destroy(&ab->lock);
+}
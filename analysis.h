@@ -0,0 +1,101 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <pthread.h>
+
+struct arena;
+struct spectrum_analyzer;
+struct onset_detector;
+struct chroma_analyzer;
+struct pitch_detector;
+
+// What an analysis is built for; the trackers are only set up if asked for.
+struct analysis_config
+{
+    int window_size;
+    int num_points;
+    int sample_rate;
+    bool huge_pages;
+
+    bool onsets;
+    bool chroma;
+    bool pitch;
+};
+
+// Everything that depends on the window size, in one arena; built and thrown
+// away as a whole.
+struct analysis
+{
+    struct analysis_config config;
+    // Holds everything below.
+    struct arena *arena;
+
+    struct spectrum_analyzer *sa;
+    // NULL unless asked for in `config`.
+    struct onset_detector *od;
+    struct chroma_analyzer *ca;
+    struct pitch_detector *pd;
+
+    // Link in the builder's list of analyses to free.
+    struct analysis *next;
+};
+
+// NULL on failure.
+struct analysis *
+analysis_create (const struct analysis_config *config);
+
+void
+analysis_destroy (struct analysis *an);
+
+// Builds analyses on a thread of its own, and frees the ones swapped out, so
+// that neither ever happens on the render thread.
+struct analysis_builder
+{
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+
+    // Guarded by `lock`.
+    struct analysis_config request;
+    bool requested;
+    bool quit;
+    struct analysis *retired;
+
+    // Built, and waiting to be taken.
+    _Atomic(struct analysis *) ready;
+};
+
+int
+analysis_builder_start (struct analysis_builder *ab);
+
+// Only the latest request is built; those still waiting are dropped.
+void
+analysis_builder_request (struct analysis_builder *ab, const struct analysis_config *config);
+
+// The latest analysis built since the last call, if any; never blocks.
+struct analysis *
+analysis_builder_take (struct analysis_builder *ab);
+
+// Hands `an` back to be destroyed on the builder thread.
+void
+analysis_builder_retire (struct analysis_builder *ab, struct analysis *an);
+
+// Waits for the thread, and destroys whatever it still holds.
+void
+analysis_builder_stop (struct analysis_builder *ab);
@@ -0,0 +1,284 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdlib.h>
+#include <math.h>
+#include <complex.h>
+
+#include "analyzer.h"
+#include "arena.h"
+
+// Genererates a von Hann window of length N.
+static void
+gen_hann_window(int N, kiss_fft_scalar *win)
+{
+    for (int i = 0; i < N; ++i)
+    {
+        const float w = 0.5 * (1.0 - cosf(2.0 * M_PI * (float)i / N));
+#ifdef VSP_FIXED_POINT
+        win[i] = lrintf(w * INT16_MAX);
+#else
+        win[i] = w;
+#endif
+    }
+}
+
+// Span of the Mel axis, 20 Hz to 20 kHz.
+static const float DELTA_MEL = 3785.184764; // 1127 * ln((20000.0 + 700.0) / (20.0 + 700.0))
+static const float MEL_MIN = 31.748578; // 1127.0 * ln(1.0 + 20.0/700.0)
+
+static inline
+float mel_to_freq(float mel)
+{
+    return 700.0 * (expf(mel / 1127.0) - 1.0);
+}
+
+static inline
+float freq_to_mel(float freq)
+{
+    return 1127.0 * logf(1.0 + freq / 700.0);
+}
+
+#ifdef VSP_FIXED_POINT
+// Bit-by-bit integer square root; exact for the whole uint32_t range.
+static inline
+uint32_t isqrt32(uint32_t x)
+{
+    uint32_t r = 0, bit = 1u << 30;
+
+    while (bit > x)
+        bit >>= 2;
+
+    while (bit)
+    {
+        if (x >= r + bit)
+        {
+            x -= r + bit;
+            r = (r >> 1) + bit;
+        } else
+            r >>= 1;
+
+        bit >>= 2;
+    }
+
+    return r;
+}
+#endif
+
+#define SA_ALWAYS_INLINE static inline __attribute__((always_inline))
+
+// Generic taper body; `n` is a compile-time constant in the specialised
+// instances below, which lets the compiler unroll and vectorise it.
+SA_ALWAYS_INLINE void
+sa_taper_n(struct spectrum_analyzer *restrict sa, const int n)
+{
+    kiss_fft_scalar *restrict win = __builtin_assume_aligned(sa->sample_win, ARENA_ALIGN);
+    const kiss_fft_scalar *restrict hann = __builtin_assume_aligned(sa->hann_win, ARENA_ALIGN);
+
+    #pragma GCC unroll 8
+    for (int i = 0; i < n; ++i)
+    {
+#ifdef VSP_FIXED_POINT
+        // Q15 × Q15, rounded back to Q15.
+        win[i] = (win[i] * hann[i] + (1 << 14)) >> 15;
+#else
+        win[i] *= hann[i];
+#endif
+    }
+}
+
+// Folds freq_bins into sm_freqs. Not specialised: the inner loop runs over each
+// point's own bin count, whatever num_points is.
+static void
+sa_reduce(struct spectrum_analyzer *restrict sa, float tau)
+{
+    const int num_points = sa->num_points;
+    const struct bin_range *restrict ranges = sa->ranges;
+    const kiss_fft_cpx *restrict freq_bins = sa->freq_bins;
+    sa_level *restrict sm_freqs = sa->sm_freqs;
+
+#ifdef VSP_FIXED_POINT
+    const uint32_t tau_q = tau * 32768;
+
+    for (int i = 0; i < num_points; ++i)
+    {
+        const kiss_fft_cpx *bins = &freq_bins[ranges[i].begin];
+
+        // Peak power; at most 2 × 32768², which still fits an uint32_t.
+        uint32_t peak = 0;
+
+        for (int bi = 0; bi < ranges[i].count; ++bi)
+        {
+            const int32_t re = bins[bi].r;
+            const int32_t im = bins[bi].i;
+            const uint32_t pow = (uint32_t)(re * re) + (uint32_t)(im * im);
+
+            peak = pow > peak ? pow : peak;
+        }
+
+        // The fixed-point transform scales its output by 1/N on its own, so this
+        // is 2·|X|/N in Q15; clamped to 2.0 so the smoothing below can't overflow.
+        uint32_t mag = 2 * isqrt32(peak);
+        mag = mag > UINT16_MAX ? UINT16_MAX : mag;
+
+        // Exponential time-smoothing to make animation smoother.
+        sm_freqs[i] = ((uint32_t)sm_freqs[i] * tau_q + (32768 - tau_q) * mag) >> 15;
+    }
+#else
+    const float FFT_SCALE = 2.0 / sa->window_size;
+
+    for (int i = 0; i < num_points; ++i)
+    {
+        const kiss_fft_cpx *bins = &freq_bins[ranges[i].begin];
+
+        float mag = 0.0;
+        complex float bin;
+
+        for (int bi = 0; bi < ranges[i].count; ++bi)
+        {
+            bin = *(complex float*)&bins[bi];
+
+            // Find the most dominant tone; band averaging is not desired,
+            // that would be computing power spectra, and not tone spectra.
+            mag = fmaxf(mag, FFT_SCALE * cabsf(bin));
+        }
+
+        // Exponential time-smoothing to make animation smoother.
+        sm_freqs[i] = sm_freqs[i] * tau + (1.0 - tau) * mag;
+    }
+#endif
+}
+
+#define SA_TAPER_KERNEL(N) \
+    static void sa_taper_##N(struct spectrum_analyzer *sa) { sa_taper_n(sa, N); }
+
+SA_TAPER_KERNEL(1024)
+SA_TAPER_KERNEL(2048)
+SA_TAPER_KERNEL(4096)
+SA_TAPER_KERNEL(8192)
+
+// Fallback for sizes without a specialised instance.
+static void
+sa_taper_any(struct spectrum_analyzer *sa)
+{
+    sa_taper_n(sa, sa->window_size);
+}
+
+static const struct { int size; sa_taper_fn fn; } taper_kernels[] = {
+    { 1024, sa_taper_1024 },
+    { 2048, sa_taper_2048 },
+    { 4096, sa_taper_4096 },
+    { 8192, sa_taper_8192 },
+};
+
+#define ARRAY_SIZE(a) (sizeof (a) / sizeof *(a))
+
+size_t
+sa_footprint (int window_size, int num_points)
+{
+    size_t fft_len = 0;
+    kiss_fftr_alloc(window_size, 0, NULL, &fft_len);
+
+    // Same order as the allocations in sa_init().
+    return ARENA_ROUND(window_size * sizeof(kiss_fft_scalar))
+         + ARENA_ROUND(window_size * sizeof(kiss_fft_scalar))
+         + ARENA_ROUND(fft_len)
+         + ARENA_ROUND((window_size / 2 + 1) * sizeof(kiss_fft_cpx))
+         + ARENA_ROUND(num_points * sizeof(struct bin_range))
+         + ARENA_ROUND(num_points * sizeof(sa_level));
+}
+
+int
+sa_init (struct spectrum_analyzer *sa,
+         struct arena *arena,
+         int window_size,
+         int num_points,
+         int sample_rate)
+{
+    sa->window_size = window_size;
+    sa->fft_size = window_size / 2 + 1;
+    sa->num_points = num_points;
+
+    size_t fft_len = 0;
+    kiss_fftr_alloc(window_size, 0, NULL, &fft_len);
+
+    // Laid out in the order sa_process() walks through them.
+    sa->sample_win = arena_alloc(arena, window_size * sizeof(kiss_fft_scalar));
+    sa->hann_win = arena_alloc(arena, window_size * sizeof(kiss_fft_scalar));
+    void *fft_mem = arena_alloc(arena, fft_len);
+    sa->freq_bins = arena_alloc(arena, sa->fft_size * sizeof(kiss_fft_cpx));
+    sa->ranges = arena_alloc(arena, num_points * sizeof(struct bin_range));
+    sa->sm_freqs = arena_alloc(arena, num_points * sizeof(sa_level));
+
+    if (!sa->sample_win || !sa->hann_win || !fft_mem || !sa->freq_bins ||
+        !sa->ranges || !sa->sm_freqs)
+        return -1;
+
+    sa->fft = kiss_fftr_alloc(window_size, 0, fft_mem, &fft_len);
+    if (!sa->fft)
+        return -1;
+
+    gen_hann_window(window_size, sa->hann_win);
+
+    const float BIN_WIDTH = (float)window_size / sample_rate;
+
+    #define index_to_mel(i) (DELTA_MEL * (float)(i) / num_points + MEL_MIN)
+
+    for (int i = 0; i < num_points; ++i)
+    {
+        const float begin = mel_to_freq(index_to_mel(i)) * BIN_WIDTH;
+        const float end = mel_to_freq(index_to_mel(i+1)) * BIN_WIDTH + 1.0;
+
+        sa->ranges[i].begin = begin;
+        sa->ranges[i].count = end - begin;
+
+        // At low sample rates the upper bands lie past Nyquist.
+        if (sa->ranges[i].begin >= sa->fft_size)
+            sa->ranges[i] = (struct bin_range) { sa->fft_size - 1, 0 };
+        else if (sa->ranges[i].begin + sa->ranges[i].count > sa->fft_size)
+            sa->ranges[i].count = sa->fft_size - sa->ranges[i].begin;
+    }
+
+    sa->taper = sa_taper_any;
+    for (size_t i = 0; i < ARRAY_SIZE(taper_kernels); ++i)
+        if (taper_kernels[i].size == window_size)
+            sa->taper = taper_kernels[i].fn;
+
+    return 0;
+}
+
+void
+sa_transform (struct spectrum_analyzer *sa)
+{
+    // Tapering the window.
+    sa->taper(sa);
+
+    // FFT.
+    kiss_fftr(sa->fft, sa->sample_win, sa->freq_bins);
+}
+
+void
+sa_process (struct spectrum_analyzer *sa, float tau)
+{
+    sa_transform(sa);
+    sa_reduce(sa, tau);
+}
+
+float
+sa_point_of (struct spectrum_analyzer *sa, float freq)
+{
+    return (freq_to_mel(freq) - MEL_MIN) * sa->num_points / DELTA_MEL;
+}
@@ -0,0 +1,82 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdint.h>
+
+#include <kiss_fftr.h>
+
+#ifdef VSP_FIXED_POINT
+// Band levels are kept in Q15 (1.0 = 32768) all the way down to the vertex stage.
+typedef int32_t sa_level;
+#define SA_LEVEL_TO_FLOAT(l) ((float)(l) * (1.0f / 32768))
+#else
+typedef float sa_level;
+#define SA_LEVEL_TO_FLOAT(l) (l)
+#endif
+
+// FFT bins [begin, begin + count) that fold into one point of the spectrum.
+struct bin_range
+{
+    int begin, count;
+};
+
+struct arena;
+struct spectrum_analyzer;
+
+typedef void (*sa_taper_fn) (struct spectrum_analyzer *sa);
+
+struct spectrum_analyzer
+{
+    int window_size;
+    int fft_size;
+    int num_points;
+
+    kiss_fftr_cfg fft;
+    kiss_fft_scalar *sample_win;
+    kiss_fft_scalar *hann_win;
+    kiss_fft_cpx *freq_bins;
+
+    struct bin_range *ranges;
+    // Exponential smoothing is applied on freq_bins.
+    sa_level *sm_freqs;
+
+    // Taper specialised for window_size; see sa_init().
+    sa_taper_fn taper;
+};
+
+// Bytes of arena that sa_init() will carve out for the given sizes.
+size_t
+sa_footprint (int window_size, int num_points);
+
+// All working memory is taken from `arena`, and lives as long as it does.
+int
+sa_init (struct spectrum_analyzer *sa,
+         struct arena *arena,
+         int window_size,
+         int num_points,
+         int sample_rate);
+
+// Tapers sample_win and transforms it into freq_bins.
+void
+sa_transform (struct spectrum_analyzer *sa);
+
+// sa_transform(), then folds the bins into sm_freqs.
+void
+sa_process (struct spectrum_analyzer *sa, float tau);
+
+// Fractional index of the point `freq` (in Hz) falls on.
+float
+sa_point_of (struct spectrum_analyzer *sa, float freq);
@@ -0,0 +1,87 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include "arena.h"
+
+// Size of a huge page on every architecture vsp is likely to meet (x86-64, AArch64).
+#define HUGE_PAGE_SIZE (2 << 20)
+
+int
+arena_init (struct arena *arena, size_t size, bool huge_pages)
+{
+    const size_t page = sysconf(_SC_PAGESIZE);
+
+    arena->base = MAP_FAILED;
+    arena->size = size;
+    arena->used = 0;
+    arena->huge_pages = false;
+
+    if (huge_pages)
+    {
+        // Explicit huge pages first (needs a reserved pool); transparent ones otherwise.
+        arena->mapped = (size + HUGE_PAGE_SIZE - 1) & ~(size_t)(HUGE_PAGE_SIZE - 1);
+        arena->base = mmap(NULL, arena->mapped, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        arena->huge_pages = arena->base != MAP_FAILED;
+    }
+
+    if (arena->base == MAP_FAILED)
+    {
+        arena->mapped = (size + page - 1) & ~(page - 1);
+        arena->base = mmap(NULL, arena->mapped, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (arena->base == MAP_FAILED)
+        {
+            arena->base = NULL;
+            return -1;
+        }
+
+        if (huge_pages)
+            madvise(arena->base, arena->mapped, MADV_HUGEPAGE);
+    }
+
+    // Fresh anonymous pages read as zero anyway, but touching them here also
+    // faults them in now rather than on the first pass through the hot loop.
+    memset(arena->base, 0, arena->mapped);
+
+    return 0;
+}
+
+void *
+arena_alloc (struct arena *arena, size_t size)
+{
+    const size_t offset = ARENA_ROUND(arena->used);
+
+    if (offset + size > arena->size)
+        return NULL;
+
+    arena->used = offset + size;
+
+    return arena->base + offset;
+}
+
+void
+arena_deinit (struct arena *arena)
+{
+    if (arena->base)
+        munmap(arena->base, arena->mapped);
+
+    arena->base = NULL;
+}
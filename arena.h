@@ -0,0 +1,44 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+
+// Every allocation starts on its own cache line.
+#define ARENA_ALIGN 64
+#define ARENA_ROUND(size) (((size) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+// A bump allocator over one zeroed mapping; everything is released at once.
+struct arena
+{
+    unsigned char *base;
+    size_t size;
+    size_t used;
+
+    // Length of the mapping; `size` rounded up to the page size.
+    size_t mapped;
+    bool huge_pages;
+};
+
+int
+arena_init (struct arena *arena, size_t size, bool huge_pages);
+
+// Returns ARENA_ALIGN-aligned, zeroed memory; NULL if the arena is exhausted.
+void *
+arena_alloc (struct arena *arena, size_t size);
+
+void
+arena_deinit (struct arena *arena);
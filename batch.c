@@ -0,0 +1,343 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "analyzer.h"
+#include "arena.h"
+#include "batch.h"
+
+// Frames per unit of work; big enough to amortise the bookkeeping, small
+// enough that the tail of the file still spreads over every thread.
+#define FRAMES_PER_CHUNK 32
+
+struct batch_job;
+
+struct batch_worker
+{
+    pthread_t thread;
+    struct batch_job *job;
+
+    // Chunks [lo, hi) this worker still owns, packed as hi << 32 | lo. The
+    // owner takes from the bottom, thieves split off the top half.
+    _Atomic uint64_t range;
+
+    // Per-thread plan and scratch; KissFFT plans aren't reentrant.
+    struct arena arena;
+    struct spectrum_analyzer sa;
+};
+
+struct batch_job
+{
+    const kiss_fft_scalar *samples;
+    size_t num_frames;
+    int hop;
+    float *out;
+
+    int num_workers;
+    struct batch_worker *workers;
+};
+
+#define RANGE(lo, hi) ((uint64_t)(hi) << 32 | (uint32_t)(lo))
+#define RANGE_LO(r) ((uint32_t)(r))
+#define RANGE_HI(r) ((uint32_t)((r) >> 32))
+
+static bool
+take_chunk (struct batch_worker *w, uint32_t *chunk)
+{
+    uint64_t r = atomic_load(&w->range);
+
+    while (RANGE_LO(r) < RANGE_HI(r))
+    {
+        if (atomic_compare_exchange_weak(&w->range, &r, RANGE(RANGE_LO(r) + 1, RANGE_HI(r))))
+        {
+            *chunk = RANGE_LO(r);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Moves the upper half of some other worker's range into the (empty) range of `thief`.
+static bool
+steal_chunks (struct batch_worker *thief)
+{
+    struct batch_job *job = thief->job;
+    const int self = thief - job->workers;
+
+    for (int k = 1; k < job->num_workers; ++k)
+    {
+        struct batch_worker *victim = &job->workers[(self + k) % job->num_workers];
+        uint64_t r = atomic_load(&victim->range);
+
+        while (RANGE_LO(r) < RANGE_HI(r))
+        {
+            const uint32_t lo = RANGE_LO(r), hi = RANGE_HI(r);
+            const uint32_t mid = hi - (hi - lo + 1) / 2;
+
+            if (atomic_compare_exchange_weak(&victim->range, &r, RANGE(lo, mid)))
+            {
+                // Nobody else writes an empty range, so a plain store is enough.
+                atomic_store(&thief->range, RANGE(mid, hi));
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+static void *
+batch_worker_run (void *userdata)
+{
+    struct batch_worker *w = userdata;
+    struct batch_job *job = w->job;
+    struct spectrum_analyzer *sa = &w->sa;
+
+    uint32_t chunk;
+
+    for (;;)
+    {
+        if (!take_chunk(w, &chunk))
+        {
+            if (!steal_chunks(w))
+                break;
+
+            continue;
+        }
+
+        const size_t begin = (size_t)chunk * FRAMES_PER_CHUNK;
+        const size_t end = begin + FRAMES_PER_CHUNK < job->num_frames
+                         ? begin + FRAMES_PER_CHUNK : job->num_frames;
+
+        for (size_t f = begin; f < end; ++f)
+        {
+            memcpy(sa->sample_win,
+                   &job->samples[f * job->hop],
+                   sa->window_size * sizeof(kiss_fft_scalar));
+
+            // With τ = 0 the smoothing step passes the band peaks through as they are.
+            sa_process(sa, 0.0);
+
+            float *row = &job->out[f * sa->num_points];
+            for (int i = 0; i < sa->num_points; ++i)
+                row[i] = SA_LEVEL_TO_FLOAT(sa->sm_freqs[i]);
+        }
+    }
+
+    return NULL;
+}
+
+size_t
+batch_num_frames (size_t len, int window_size, int hop)
+{
+    return len < (size_t)window_size ? 0 : (len - window_size) / hop + 1;
+}
+
+int
+batch_analyze (const kiss_fft_scalar *samples,
+               size_t len,
+               int hop,
+               int window_size,
+               int num_points,
+               int sample_rate,
+               int jobs,
+               float *out)
+{
+    struct batch_job job = {
+        .samples = samples,
+        .num_frames = batch_num_frames(len, window_size, hop),
+        .hop = hop,
+        .out = out,
+        .num_workers = jobs,
+    };
+    const size_t num_chunks = (job.num_frames + FRAMES_PER_CHUNK - 1) / FRAMES_PER_CHUNK;
+    int started = 0, ret = -1;
+
+    if (num_chunks > UINT32_MAX)
+        return -1;
+
+    job.workers = calloc(jobs, sizeof *job.workers);
+    if (!job.workers)
+        return -1;
+
+    for (int i = 0; i < jobs; ++i)
+    {
+        struct batch_worker *w = &job.workers[i];
+
+        w->job = &job;
+        // Contiguous shares to begin with; stealing evens out the rest.
+        atomic_init(&w->range, RANGE(num_chunks * i / jobs, num_chunks * (i + 1) / jobs));
+
+        if (arena_init(&w->arena, sa_footprint(window_size, num_points), false) != 0 ||
+            sa_init(&w->sa, &w->arena, window_size, num_points, sample_rate) != 0)
+            goto error;
+    }
+
+    // Every range is in place before anyone starts stealing.
+    for (; started < jobs; ++started)
+        if (pthread_create(&job.workers[started].thread, NULL,
+                           batch_worker_run, &job.workers[started]) != 0)
+            break;
+
+    // Whatever the missing threads would've done gets stolen by the others;
+    // with no threads at all, do it here.
+    if (started == 0)
+        batch_worker_run(&job.workers[0]);
+
+    ret = 0;
+error:
+    for (int i = 0; i < started; ++i)
+        pthread_join(job.workers[i].thread, NULL);
+
+    for (int i = 0; i < jobs; ++i)
+        arena_deinit(&job.workers[i].arena);
+
+    free(job.workers);
+
+    return ret;
+}
+
+static double
+now (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+const kiss_fft_scalar *
+batch_map (const char *input, size_t *len)
+{
+    struct stat st;
+
+    const int fd = open(input, O_RDONLY);
+    if (fd < 0 || fstat(fd, &st) != 0)
+    {
+        perror(input);
+        if (fd >= 0)
+            close(fd);
+        return NULL;
+    }
+
+    // mmap() won't map nothing.
+    if (st.st_size == 0)
+    {
+        fprintf(stderr, "%s: empty :(\n", input);
+        close(fd);
+        return NULL;
+    }
+
+    void *samples = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (samples == MAP_FAILED)
+    {
+        perror(input);
+        return NULL;
+    }
+
+    // Workers walk through the file front to back.
+    madvise(samples, st.st_size, MADV_SEQUENTIAL);
+
+    *len = st.st_size / sizeof(kiss_fft_scalar);
+
+    return samples;
+}
+
+void
+batch_unmap (const kiss_fft_scalar *samples, size_t len)
+{
+    munmap((void *)samples, len * sizeof(kiss_fft_scalar));
+}
+
+int
+batch_spectrogram (const char *input,
+                   const char *output,
+                   int window_size,
+                   int num_points,
+                   int sample_rate,
+                   int jobs)
+{
+    float *out = NULL;
+    FILE *out_file = NULL;
+    size_t len = 0;
+    int ret = -1;
+
+    const kiss_fft_scalar *samples = batch_map(input, &len);
+    if (!samples)
+        return -1;
+
+    const int hop = window_size / 2;
+    const size_t num_frames = batch_num_frames(len, window_size, hop);
+
+    if (num_frames == 0)
+    {
+        fprintf(stderr, "%s: shorter than one window :(\n", input);
+        goto error;
+    }
+
+    out = malloc(num_frames * num_points * sizeof(float));
+    if (!out)
+        goto error;
+
+    const double start = now();
+
+    if (batch_analyze(samples, len, hop, window_size, num_points, sample_rate, jobs, out) != 0)
+    {
+        fputs("Batch analysis failed :(\n", stderr);
+        goto error;
+    }
+
+    const double elapsed = now() - start;
+
+    fprintf(stderr, "%zu frames x %d points on %d threads in %.3f s (%.0f frames/s, %.0fx real time)\n",
+            num_frames, num_points, jobs, elapsed, num_frames / elapsed,
+            (double)len / sample_rate / elapsed);
+
+    out_file = strcmp(output, "-") == 0 ? stdout : fopen(output, "wb");
+    if (!out_file || fwrite(out, sizeof(float) * num_points, num_frames, out_file) != num_frames)
+    {
+        perror(output);
+        goto error;
+    }
+
+    ret = 0;
+error:
+    if (out_file && out_file != stdout)
+        fclose(out_file);
+    else if (out_file)
+        fflush(out_file);
+
+    free(out);
+    batch_unmap(samples, len);
+
+    return ret;
+}
@@ -0,0 +1,54 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stddef.h>
+
+#include <kiss_fftr.h>
+
+// Number of whole windows of `window_size` samples, `hop` apart, in `len` samples.
+size_t
+batch_num_frames (size_t len, int window_size, int hop);
+
+// Computes the (unsmoothed) Mel peak spectrum of every frame on `jobs` threads,
+// writing batch_num_frames() rows of `num_points` floats to `out`. Each frame
+// is computed on its own, so the result doesn't depend on the thread count.
+int
+batch_analyze (const kiss_fft_scalar *samples,
+               size_t len,
+               int hop,
+               int window_size,
+               int num_points,
+               int sample_rate,
+               int jobs,
+               float *out);
+
+// Maps a raw mono file (native-endian samples of the build's sample type) to
+// read front to back; `len` is in samples. NULL on failure, which is reported.
+const kiss_fft_scalar *
+batch_map (const char *input, size_t *len);
+
+void
+batch_unmap (const kiss_fft_scalar *samples, size_t len);
+
+// Runs batch_analyze() over a raw mono file (native-endian samples of the
+// build's sample type) and writes the matrix to `output` ("-" for stdout).
+int
+batch_spectrogram (const char *input,
+                   const char *output,
+                   int window_size,
+                   int num_points,
+                   int sample_rate,
+                   int jobs);
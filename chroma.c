@@ -0,0 +1,239 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <math.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "chroma.h"
+
+// Frequency range folded into the chroma; below the lower end a single bin
+// would span more than a semitone.
+static const float CHROMA_MIN_HZ = 65.0;
+static const float CHROMA_MAX_HZ = 5000.0;
+// Peaks weaker than this (relative to the strongest bin) don't vote on the tuning.
+static const float TUNING_PEAK_FLOOR = 0.01;
+// Memory of the tuning estimate, in hops.
+static const float TUNING_DECAY = 0.995;
+// The table is rebuilt when the estimate drifts this far (in semitones).
+static const float TUNING_SLACK = 0.02;
+
+static void
+chroma_range (int window_size, int sample_rate, int *first, int *count)
+{
+    const float bin_hz = (float)sample_rate / window_size;
+    const float min_hz = fmaxf(CHROMA_MIN_HZ, bin_hz / (exp2f(1.0 / 12) - 1.0));
+    const float max_hz = fminf(CHROMA_MAX_HZ, sample_rate / 2.0);
+
+    *first = ceilf(min_hz / bin_hz);
+    *count = max_hz > min_hz ? floorf(max_hz / bin_hz) - *first + 1 : 0;
+}
+
+size_t
+chroma_footprint (int window_size, int sample_rate)
+{
+    int first, count;
+    chroma_range(window_size, sample_rate, &first, &count);
+
+    return ARENA_ROUND(count * sizeof(struct chroma_entry))
+         + ARENA_ROUND(count * sizeof(float))
+         + ARENA_ROUND(count * sizeof(int));
+}
+
+static inline float
+hz_to_midi (float hz)
+{
+    return 69.0 + 12.0 * log2f(hz / 440.0);
+}
+
+// log2 to within 1e-5, for the tuning's peaks, where logf() would be most of the
+// cost: the exponent, and the atanh series over a mantissa in [√½, √2). For
+// positive, normal `x` only.
+static inline float
+fast_log2f (float x)
+{
+    union { float f; uint32_t i; } u = { x };
+
+    // The exponent that leaves the mantissa in [√½, √2), √½ being 0x3f3504f3;
+    // no branch, which the peaks would mispredict on half the time.
+    const int e = (int32_t)(u.i - 0x3f3504f3) >> 23;
+    u.i -= (uint32_t)e << 23;
+
+    const float y = (u.f - 1.0f) / (u.f + 1.0f);
+    const float y2 = y * y;
+
+    // 2/ln 2 · (y + y³/3 + y⁵/5)
+    return e + 2.8853901f * y * (1.0f + y2 * (1.0f / 3 + y2 * (1.0f / 5)));
+}
+
+// cos and sin of 2π·f, for f in [-½, ½], to about 1e-2: Taylor series at half
+// the angle (π/2 at most), then doubled. Plenty for a vote on the tuning.
+static inline void
+fast_turn (float f, float *cos_out, float *sin_out)
+{
+    const float x = (float)M_PI * f;
+    const float x2 = x * x;
+
+    const float s = x * (1.0f - x2 / 6 * (1.0f - x2 / 20));
+    const float c = 1.0f - x2 / 2 * (1.0f - x2 / 12 * (1.0f - x2 / 30));
+
+    *cos_out = c * c - s * s;
+    *sin_out = 2.0f * s * c;
+}
+
+// Lays the entries out for the current tuning estimate.
+static void
+chroma_map (struct chroma_analyzer *ca)
+{
+    for (int i = 0; i < ca->num_entries; ++i)
+    {
+        const float s = hz_to_midi((ca->first_bin + i) * ca->bin_hz) - ca->tuning;
+        const float c = floorf(s);
+
+        ca->entries[i] = (struct chroma_entry) {
+            .pitch_class = (int)c % CHROMA_CLASSES,
+            .weight = 1.0 - (s - c),
+        };
+    }
+
+    ca->table_tuning = ca->tuning;
+}
+
+int
+chroma_init (struct chroma_analyzer *ca,
+             struct arena *arena,
+             int window_size,
+             int sample_rate)
+{
+    chroma_range(window_size, sample_rate, &ca->first_bin, &ca->num_entries);
+
+    ca->bin_hz = (float)sample_rate / window_size;
+#ifdef VSP_FIXED_POINT
+    ca->power_scale = 1.0;
+#else
+    // Keeps the powers in the same ballpark as the Q15 ones; only ratios matter.
+    ca->power_scale = powf(32768.0 / window_size, 2);
+#endif
+
+    ca->entries = arena_alloc(arena, ca->num_entries * sizeof(struct chroma_entry));
+    ca->power = arena_alloc(arena, ca->num_entries * sizeof(float));
+    ca->peaks = arena_alloc(arena, ca->num_entries * sizeof(int));
+    if ((!ca->entries || !ca->power || !ca->peaks) && ca->num_entries > 0)
+        return -1;
+
+    ca->tuning = 0.0;
+    ca->tuning_re = ca->tuning_im = 0.0;
+    for (int i = 0; i < CHROMA_CLASSES; ++i)
+        ca->chroma[i] = 0.0;
+
+    chroma_map(ca);
+
+    return 0;
+}
+
+static inline float
+bin_power (const kiss_fft_cpx *bin)
+{
+    return (float)bin->r * bin->r + (float)bin->i * bin->i;
+}
+
+void
+chroma_process (struct chroma_analyzer *ca, const kiss_fft_cpx *freq_bins, float tau)
+{
+    const kiss_fft_cpx *bins = &freq_bins[ca->first_bin];
+    float *restrict power = ca->power;
+    int *restrict peaks = ca->peaks;
+    const int n = ca->num_entries;
+
+    float pc[CHROMA_CLASSES + 1] = {0};
+    float peak_power = 0.0;
+
+    for (int i = 0; i < n; ++i)
+    {
+        const float p = bin_power(&bins[i]) * ca->power_scale;
+        const struct chroma_entry e = ca->entries[i];
+
+        power[i] = p;
+
+        // pc[12] is folded back into C below, which saves a modulo here.
+        pc[e.pitch_class] += e.weight * p;
+        pc[e.pitch_class + 1] += (1.0 - e.weight) * p;
+
+        // Not fmaxf(), which is a call per bin unless NaNs are ruled out.
+        peak_power = p > peak_power ? p : peak_power;
+    }
+
+    pc[0] += pc[CHROMA_CLASSES];
+
+    // Tuning; every clear spectral peak votes with its deviation from the
+    // nearest semitone, averaged on the circle so that ±0.5 don't cancel out.
+    // The peaks are gathered first, without a branch per bin; noise has one
+    // every few bins, and would mispredict on most of them.
+    const float power_floor = peak_power * TUNING_PEAK_FLOOR;
+    int num_peaks = 0;
+
+    for (int i = 1; i < n - 1; ++i)
+    {
+        peaks[num_peaks] = i;
+        num_peaks += (power[i] > power_floor) & (power[i] > power[i - 1]) & (power[i] >= power[i + 1]);
+    }
+
+    const float midi_of_bin_1 = hz_to_midi(ca->bin_hz);
+    float tuning_re = 0.0, tuning_im = 0.0;
+
+    for (int j = 0; j < num_peaks; ++j)
+    {
+        const int i = peaks[j];
+        const float a = power[i - 1] + 1e-9f, b = power[i], c = power[i + 1] + 1e-9f;
+        const float inv_b = 1.0f / b;
+
+        // Parabolic interpolation on the log-power. Only differences of the
+        // logs enter it, and only in a ratio, so base 2 does as well as e,
+        // taken of the outer two powers over the middle one.
+        const float la = fast_log2f(a * inv_b), lc = fast_log2f(c * inv_b);
+        const float denom = la + lc;
+        const float offset = denom < 0 ? 0.5f * (la - lc) / denom : 0.0f;
+
+        // MIDI numbers are positive, so the cast rounds to the nearest semitone.
+        const float s = midi_of_bin_1 + 12.0f * fast_log2f(ca->first_bin + i + offset);
+        const float w = sqrtf(b);
+        float re, im;
+
+        fast_turn(s - (int)(s + 0.5f), &re, &im);
+        tuning_re += w * re;
+        tuning_im += w * im;
+    }
+
+    ca->tuning_re += tuning_re;
+    ca->tuning_im += tuning_im;
+    ca->tuning_re *= TUNING_DECAY;
+    ca->tuning_im *= TUNING_DECAY;
+
+    if (ca->tuning_re != 0.0 || ca->tuning_im != 0.0)
+        ca->tuning = atan2f(ca->tuning_im, ca->tuning_re) / (2 * M_PI);
+
+    if (fabsf(ca->tuning - ca->table_tuning) > TUNING_SLACK)
+        chroma_map(ca);
+
+    float max = 0.0;
+    for (int i = 0; i < CHROMA_CLASSES; ++i)
+        max = fmaxf(max, pc[i]);
+
+    const float norm = max > 0.0 ? 1.0 / max : 0.0;
+
+    for (int i = 0; i < CHROMA_CLASSES; ++i)
+        ca->chroma[i] = ca->chroma[i] * tau + (1.0 - tau) * pc[i] * norm;
+}
@@ -0,0 +1,67 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stddef.h>
+
+#include <kiss_fftr.h>
+
+#define CHROMA_CLASSES 12
+
+struct arena;
+
+// Splits the power of one FFT bin between pitch class `pitch_class` (by
+// `weight`) and the next one up (by 1 - `weight`).
+struct chroma_entry
+{
+    int pitch_class;
+    float weight;
+};
+
+struct chroma_analyzer
+{
+    // Bins [first_bin, first_bin + num_entries) are mapped, one entry each.
+    int first_bin;
+    int num_entries;
+    struct chroma_entry *entries;
+    // Power of each of those bins, as folded, for the tuning's peak search to
+    // reuse; and the peaks it finds, as indices into it.
+    float *power;
+    int *peaks;
+
+    float bin_hz;
+    float power_scale;
+
+    // Estimated deviation from A440 tuning in semitones, and the deviation
+    // the entries were last laid out for.
+    float tuning;
+    float table_tuning;
+    float tuning_re, tuning_im;
+
+    // Pitch classes from C up; normalised so that the strongest is 1.
+    float chroma[CHROMA_CLASSES];
+};
+
+size_t
+chroma_footprint (int window_size, int sample_rate);
+
+int
+chroma_init (struct chroma_analyzer *ca,
+             struct arena *arena,
+             int window_size,
+             int sample_rate);
+
+void
+chroma_process (struct chroma_analyzer *ca, const kiss_fft_cpx *freq_bins, float tau);
@@ -0,0 +1,87 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "command_queue.h"
+
+void
+cq_init (struct command_queue* cq)
+{
+    atomic_init(&cq->head, 0);
+    atomic_init(&cq->tail, 0);
+}
+
+bool
+cq_push (struct command_queue* cq, const struct cq_command* cmd)
+{
+    const unsigned head = atomic_load_explicit(&cq->head, memory_order_relaxed);
+    const unsigned tail = atomic_load_explicit(&cq->tail, memory_order_acquire);
+
+    if (head - tail == CQ_SIZE)
+        return false;
+
+    cq->commands[head % CQ_SIZE] = *cmd;
+    // Publishes the command along with the new head.
+    atomic_store_explicit(&cq->head, head + 1, memory_order_release);
+
+    return true;
+}
+
+bool
+cq_pop (struct command_queue* cq, struct cq_command* cmd)
+{
+    const unsigned tail = atomic_load_explicit(&cq->tail, memory_order_relaxed);
+    const unsigned head = atomic_load_explicit(&cq->head, memory_order_acquire);
+
+    if (head == tail)
+        return false;
+
+    *cmd = cq->commands[tail % CQ_SIZE];
+    // The slot can be written again once this is seen.
+    atomic_store_explicit(&cq->tail, tail + 1, memory_order_release);
+
+    return true;
+}
+
+// Set in the size word whenever one is waiting, even a 0x0 one.
+#define CQ_SIZE_PENDING ((uint_least64_t)1 << 63)
+
+void
+cq_size_init (struct cq_size* cs)
+{
+    atomic_init(&cs->size, 0);
+}
+
+void
+cq_size_set (struct cq_size* cs, int width, int height)
+{
+    const uint_least64_t size = (uint_least64_t)(uint32_t)width << 32 | (uint32_t)height;
+
+    atomic_store_explicit(&cs->size, CQ_SIZE_PENDING | size, memory_order_relaxed);
+}
+
+bool
+cq_size_take (struct cq_size* cs, int* width, int* height)
+{
+    const uint_least64_t size = atomic_exchange_explicit(&cs->size, 0, memory_order_relaxed);
+
+    if (!size)
+        return false;
+
+    *width = (int)(uint32_t)((size & ~CQ_SIZE_PENDING) >> 32);
+    *height = (int)(uint32_t)size;
+
+    return true;
+}
@@ -0,0 +1,80 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// Commands that can be waiting at once; a power of two.
+#define CQ_SIZE 256
+
+enum cq_type
+{
+    CQ_GAIN,
+    CQ_TAU,
+    CQ_SCOPE,
+    CQ_ZOOM,
+};
+
+struct cq_command
+{
+    enum cq_type type;
+    // Which window it's for: 0 for the first one, i + 1 for the view i.
+    int window;
+    // Step of CQ_GAIN (in dB), CQ_TAU, or CQ_ZOOM (+1 to double the window,
+    // -1 to halve it).
+    float delta;
+};
+
+// Single producer, single consumer ring: the GLFW event thread pushes what
+// the keys ask for, and the render thread takes it all at
+// the start of a frame. Neither side ever waits on the other.
+struct command_queue
+{
+    struct cq_command commands[CQ_SIZE];
+    // Free-running; only the producer writes `head`, only the consumer `tail`.
+    atomic_uint head, tail;
+};
+
+void
+cq_init (struct command_queue* cq);
+
+// false if the queue is full, and the command was dropped.
+bool
+cq_push (struct command_queue* cq, const struct cq_command* cmd);
+
+// false if there's nothing waiting.
+bool
+cq_pop (struct command_queue* cq, struct cq_command* cmd);
+
+// A window's latest framebuffer size. A live resize fires for every step of
+// the drag, and only the last one matters, so it's overwritten, not queued,
+// and can't be dropped. Both halves go in one word, so they're never torn.
+struct cq_size
+{
+    // 0 if nothing's waiting.
+    atomic_uint_least64_t size;
+};
+
+void
+cq_size_init (struct cq_size* cs);
+
+void
+cq_size_set (struct cq_size* cs, int width, int height);
+
+// false if the size hasn't changed since it was last taken.
+bool
+cq_size_take (struct cq_size* cs, int* width, int* height);
@@ -0,0 +1,508 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "analyzer.h"
+#include "gpu_fft.h"
+#include "program_cache.h"
+
+// Workgroup size of the multi-pass kernels.
+static const int GPU_FFT_LOCAL = 64;
+
+// Compiled three times over, with KERNEL_SHARED, KERNEL_STAGE or KERNEL_POST
+// defined; N is the (real) window length and M = N/2 that of the complex
+// transform underneath.
+static const char *gpu_fft_source =
+"layout(local_size_x = LOCAL) in;\n"
+"\n"
+"uniform SAMPLER samples;\n"
+"uniform int ns;\n"
+"uniform int radix;\n"
+"uniform bool first;\n"
+"\n"
+"layout(std430, binding = 0) readonly buffer Twiddles { vec2 twiddle[]; };\n"
+"layout(std430, binding = 1) readonly buffer Window { float hann[]; };\n"
+"layout(std430, binding = 2) readonly buffer Src { vec2 src[]; };\n"
+"layout(std430, binding = 3) writeonly buffer Dst { vec2 dst[]; };\n"
+"\n"
+"vec2 cmul(vec2 a, vec2 b) {\n"
+"    return vec2(a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);\n"
+"}\n"
+"\n"
+"// z[n] = x[2n] + i x[2n+1], tapered.\n"
+"vec2 tapered(int n) {\n"
+"    return SAMPLE_SCALE * vec2(float(texelFetch(samples, 2 * n).r) * hann[2 * n],\n"
+"                               float(texelFetch(samples, 2 * n + 1).r) * hann[2 * n + 1]);\n"
+"}\n"
+"\n"
+"// Twiddles of the M-point transform; W_M^e = W_N^2e.\n"
+"vec2 w(int e) {\n"
+"    return twiddle[2 * e];\n"
+"}\n"
+"\n"
+"void butterfly4(inout vec2 a, inout vec2 b, inout vec2 c, inout vec2 d) {\n"
+"    vec2 t0 = a + c, t1 = a - c, t2 = b + d, t3 = b - d;\n"
+"    vec2 t3i = vec2(t3.y, -t3.x); // -i t3\n"
+"    a = t0 + t2; b = t1 + t3i; c = t0 - t2; d = t1 - t3i;\n"
+"}\n"
+"\n"
+"// X[k] of the real input, from Z[k] and Z[M-k] of the packed one.\n"
+"vec2 untangle(vec2 zk, vec2 zmk, int k) {\n"
+"    vec2 c = vec2(zmk.x, -zmk.y);\n"
+"    vec2 even = 0.5 * (zk + c);\n"
+"    vec2 odd = 0.5 * (zk - c);\n"
+"    return even + cmul(twiddle[k], vec2(odd.y, -odd.x));\n"
+"}\n"
+"\n"
+"#if defined(KERNEL_SHARED)\n"
+"// The whole transform in one workgroup of M/4, in shared memory.\n"
+"shared vec2 buf[M];\n"
+"\n"
+"void main() {\n"
+"    int t = int(gl_LocalInvocationID.x);\n"
+"\n"
+"    for (int i = 0; i < 4; ++i)\n"
+"        buf[t + i * LOCAL] = tapered(t + i * LOCAL);\n"
+"    barrier();\n"
+"\n"
+"    int s = 1;\n"
+"    for (; s * 4 <= M; s *= 4) {\n"
+"        int k = t % s;\n"
+"        int e = k * (M / (s * 4));\n"
+"        vec2 v0 = buf[t];\n"
+"        vec2 v1 = cmul(buf[t + M / 4], w(e));\n"
+"        vec2 v2 = cmul(buf[t + M / 2], w(2 * e));\n"
+"        vec2 v3 = cmul(buf[t + 3 * M / 4], w(3 * e));\n"
+"        butterfly4(v0, v1, v2, v3);\n"
+"        barrier();\n"
+"\n"
+"        int o = (t / s) * s * 4 + k;\n"
+"        buf[o] = v0; buf[o + s] = v1; buf[o + 2 * s] = v2; buf[o + 3 * s] = v3;\n"
+"        barrier();\n"
+"    }\n"
+"\n"
+"    // M = 2·4^n; a radix-2 pass is left, two butterflies per invocation.\n"
+"    if (s < M) {\n"
+"        vec2 a[2], b[2];\n"
+"        for (int i = 0; i < 2; ++i) {\n"
+"            int j = t + i * LOCAL;\n"
+"            a[i] = buf[j];\n"
+"            b[i] = cmul(buf[j + M / 2], w((j % s) * (M / (s * 2))));\n"
+"        }\n"
+"        barrier();\n"
+"\n"
+"        for (int i = 0; i < 2; ++i) {\n"
+"            int j = t + i * LOCAL;\n"
+"            int o = (j / s) * s * 2 + j % s;\n"
+"            buf[o] = a[i] + b[i]; buf[o + s] = a[i] - b[i];\n"
+"        }\n"
+"        barrier();\n"
+"    }\n"
+"\n"
+"    for (int i = 0; i < 4; ++i) {\n"
+"        int k = t + i * LOCAL;\n"
+"        dst[k] = untangle(buf[k], buf[(M - k) % M], k);\n"
+"    }\n"
+"    if (t == 0)\n"
+"        dst[M] = untangle(buf[0], buf[0], M);\n"
+"}\n"
+"#elif defined(KERNEL_STAGE)\n"
+"// One radix-4 or radix-2 pass through global memory; the first one packs the samples.\n"
+"vec2 load(int i) {\n"
+"    return first ? tapered(i) : src[i];\n"
+"}\n"
+"\n"
+"void main() {\n"
+"    int j = int(gl_GlobalInvocationID.x);\n"
+"    if (j >= M / radix)\n"
+"        return;\n"
+"\n"
+"    int k = j % ns;\n"
+"    int e = k * (M / (ns * radix));\n"
+"    int o = (j / ns) * ns * radix + k;\n"
+"\n"
+"    if (radix == 4) {\n"
+"        vec2 v0 = load(j);\n"
+"        vec2 v1 = cmul(load(j + M / 4), w(e));\n"
+"        vec2 v2 = cmul(load(j + M / 2), w(2 * e));\n"
+"        vec2 v3 = cmul(load(j + 3 * M / 4), w(3 * e));\n"
+"        butterfly4(v0, v1, v2, v3);\n"
+"        dst[o] = v0; dst[o + ns] = v1; dst[o + 2 * ns] = v2; dst[o + 3 * ns] = v3;\n"
+"    } else {\n"
+"        vec2 a = load(j);\n"
+"        vec2 b = cmul(load(j + M / 2), w(e));\n"
+"        dst[o] = a + b; dst[o + ns] = a - b;\n"
+"    }\n"
+"}\n"
+"#elif defined(KERNEL_POST)\n"
+"void main() {\n"
+"    int k = int(gl_GlobalInvocationID.x);\n"
+"    if (k <= M)\n"
+"        dst[k] = untangle(src[k % M], src[(M - k) % M], k);\n"
+"}\n"
+"#endif\n";
+
+static GLuint
+compute_program (const struct gpu_fft *gf, const char *kernel, int local)
+{
+    char prefix[256];
+    snprintf(prefix, sizeof prefix,
+             "#version 430 core\n"
+             "#define %s\n"
+             "#define N %d\n"
+             "#define M %d\n"
+             "#define LOCAL %d\n"
+             "#define SAMPLER %s\n"
+             "#define SAMPLE_SCALE %s\n",
+             kernel, gf->window_size, gf->window_size / 2, local,
+             gf->sample_format == GL_R16I ? "isamplerBuffer" : "samplerBuffer",
+             gf->sample_format == GL_R16I ? "(1.0 / 32768.0)" : "1.0");
+
+    const char *sources[] = { prefix, gpu_fft_source };
+    const uint64_t key = pc_key(sources, 2);
+
+    GLuint program = pc_load(key);
+    if (program)
+    {
+        glUseProgram(program);
+        glUniform1i(glGetUniformLocation(program, "samples"), 0);
+
+        return program;
+    }
+
+    program = glCreateProgram();
+    GLuint shader = glCreateShader(GL_COMPUTE_SHADER);
+
+    glShaderSource(shader, 2, sources, NULL);
+    glCompileShader(shader);
+    glAttachShader(program, shader);
+    pc_prepare(program);
+    glLinkProgram(program);
+
+    char log[1024];
+    GLint status;
+    glGetShaderInfoLog(shader, sizeof log, NULL, log);
+    glDeleteShader(shader);
+
+    glGetProgramiv(program, GL_LINK_STATUS, &status);
+    if (!status)
+    {
+        // The compiler's log says more than the linker's.
+        if (!log[0])
+            glGetProgramInfoLog(program, sizeof log, NULL, log);
+        fprintf(stderr, "GPU FFT %s kernel failed to build :(\n%s\n", kernel, log);
+
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    pc_store(key, program);
+
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "samples"), 0);
+
+    return program;
+}
+
+static GLuint
+storage_buffer (GLsizeiptr size, const void *data)
+{
+    GLuint buffer;
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, buffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, size, data, GL_STATIC_DRAW);
+
+    return buffer;
+}
+
+int
+gpu_fft_init (struct gpu_fft *gf, int window_size, GLenum sample_format)
+{
+    const int N = window_size, M = window_size / 2;
+
+    memset(gf, 0, sizeof *gf);
+    gf->window_size = window_size;
+    gf->sample_format = sample_format;
+
+    if (N < 8 || (N & (N - 1)) != 0)
+    {
+        fprintf(stderr, "GPU FFT needs a power-of-two window :(\n");
+        return -1;
+    }
+
+    if (!GLAD_GL_ARB_compute_shader || !GLAD_GL_ARB_shader_storage_buffer_object ||
+        !GLAD_GL_ARB_shader_image_load_store)
+    {
+        fprintf(stderr, "GPU FFT needs compute shaders (OpenGL 4.3) :(\n");
+        return -1;
+    }
+
+    GLint max_shared, max_invocations, max_size;
+    glGetIntegerv(GL_MAX_COMPUTE_SHARED_MEMORY_SIZE, &max_shared);
+    glGetIntegerv(GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS, &max_invocations);
+    glGetIntegeri_v(GL_MAX_COMPUTE_WORK_GROUP_SIZE, 0, &max_size);
+
+    // GL 4.3 guarantees 32 KiB and 1024 invocations, i.e. windows up to 8192.
+    gf->shared = M * 2 * sizeof(GLfloat) <= (size_t)max_shared
+              && M / 4 <= max_invocations && M / 4 <= max_size;
+
+    if (gf->shared)
+    {
+        gf->shared_program = compute_program(gf, "KERNEL_SHARED", M / 4);
+        if (!gf->shared_program)
+            return -1;
+    } else
+    {
+        gf->stage_program = compute_program(gf, "KERNEL_STAGE", GPU_FFT_LOCAL);
+        gf->post_program = compute_program(gf, "KERNEL_POST", GPU_FFT_LOCAL);
+        if (!gf->stage_program || !gf->post_program)
+            return -1;
+
+        gf->ns_location = glGetUniformLocation(gf->stage_program, "ns");
+        gf->radix_location = glGetUniformLocation(gf->stage_program, "radix");
+        gf->first_location = glGetUniformLocation(gf->stage_program, "first");
+    }
+
+    // W_N^k, and the window, worked out in double precision.
+    GLfloat *twiddles = malloc(N * 2 * sizeof(GLfloat));
+    GLfloat *hann = malloc(N * sizeof(GLfloat));
+    if (!twiddles || !hann)
+    {
+        free(twiddles);
+        free(hann);
+        return -1;
+    }
+
+    for (int k = 0; k < N; ++k)
+    {
+        twiddles[2 * k] = cos(-2.0 * M_PI * k / N);
+        twiddles[2 * k + 1] = sin(-2.0 * M_PI * k / N);
+        hann[k] = 0.5 * (1.0 - cos(2.0 * M_PI * k / N));
+    }
+
+    gf->twiddle_buffer = storage_buffer(N * 2 * sizeof(GLfloat), twiddles);
+    gf->hann_buffer = storage_buffer(N * sizeof(GLfloat), hann);
+    gf->bins_buffer = storage_buffer((M + 1) * 2 * sizeof(GLfloat), NULL);
+
+    free(twiddles);
+    free(hann);
+
+    if (!gf->shared)
+    {
+        gf->work_buffer[0] = storage_buffer(M * 2 * sizeof(GLfloat), NULL);
+        gf->work_buffer[1] = storage_buffer(M * 2 * sizeof(GLfloat), NULL);
+    }
+
+    glGenBuffers(1, &gf->samples_buffer);
+    glGenTextures(1, &gf->samples_texture);
+    glBindBuffer(GL_TEXTURE_BUFFER, gf->samples_buffer);
+    glBufferData(GL_TEXTURE_BUFFER, N * (sample_format == GL_R16I ? sizeof(GLshort) : sizeof(GLfloat)),
+                 NULL, GL_STREAM_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, gf->samples_texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, sample_format, gf->samples_buffer);
+
+    return 0;
+}
+
+#define GROUPS(n) (((n) + GPU_FFT_LOCAL - 1) / GPU_FFT_LOCAL)
+
+void
+gpu_fft_process (struct gpu_fft *gf, const void *samples)
+{
+    const int N = gf->window_size, M = gf->window_size / 2;
+
+    // Orphaned every time, like the vertex uploads.
+    glBindBuffer(GL_TEXTURE_BUFFER, gf->samples_buffer);
+    glBufferData(GL_TEXTURE_BUFFER, N * (gf->sample_format == GL_R16I ? sizeof(GLshort) : sizeof(GLfloat)),
+                 samples, GL_STREAM_DRAW);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, gf->samples_texture);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, gf->twiddle_buffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, gf->hann_buffer);
+
+    if (gf->shared)
+    {
+        glUseProgram(gf->shared_program);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gf->bins_buffer);
+        glDispatchCompute(1, 1, 1);
+    } else
+    {
+        // Ping-pong between the work buffers, a dispatch per pass.
+        int current = 0, ns = 1;
+
+        glUseProgram(gf->stage_program);
+
+        while (ns < M)
+        {
+            const int radix = ns * 4 <= M ? 4 : 2;
+
+            glUniform1i(gf->ns_location, ns);
+            glUniform1i(gf->radix_location, radix);
+            glUniform1i(gf->first_location, ns == 1);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gf->work_buffer[1 - current]);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gf->work_buffer[current]);
+            glDispatchCompute(GROUPS(M / radix), 1, 1);
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
+
+            current = 1 - current;
+            ns *= radix;
+        }
+
+        glUseProgram(gf->post_program);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, gf->work_buffer[1 - current]);
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, gf->bins_buffer);
+        glDispatchCompute(GROUPS(M + 1), 1, 1);
+    }
+
+    // The bins are read as a buffer texture when drawing, or read back by gpu_fft_check().
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT | GL_BUFFER_UPDATE_BARRIER_BIT);
+}
+
+// A few tones and some noise, at about half of full scale.
+static void
+test_signal (kiss_fft_scalar *samples, int len)
+{
+    uint32_t seed = 1;
+
+    for (int i = 0; i < len; ++i)
+    {
+        seed = seed * 1664525 + 1013904223;
+
+        const float v = 0.3 * sinf(2.0 * M_PI * 0.0123 * i)
+                      + 0.1 * sinf(2.0 * M_PI * 0.2111 * i)
+                      + 0.05 * ((float)(seed >> 8) / (1 << 24) - 0.5);
+#ifdef VSP_FIXED_POINT
+        samples[i] = lrintf(v * INT16_MAX);
+#else
+        samples[i] = v;
+#endif
+    }
+}
+
+float
+gpu_fft_check (struct gpu_fft *gf, struct spectrum_analyzer *sa)
+{
+    const int N = gf->window_size, M = gf->window_size / 2;
+
+    kiss_fft_scalar *signal = malloc(N * sizeof(kiss_fft_scalar));
+    GLfloat *bins = malloc((M + 1) * 2 * sizeof(GLfloat));
+    if (!signal || !bins)
+    {
+        free(signal);
+        free(bins);
+        return INFINITY;
+    }
+
+    test_signal(signal, N);
+
+    gpu_fft_process(gf, signal);
+    glBindBuffer(GL_COPY_READ_BUFFER, gf->bins_buffer);
+    glGetBufferSubData(GL_COPY_READ_BUFFER, 0, (M + 1) * 2 * sizeof(GLfloat), bins);
+
+    memcpy(sa->sample_win, signal, N * sizeof(kiss_fft_scalar));
+    sa_transform(sa);
+
+    // Compared as the levels sa_reduce_n() would take the peaks of.
+#ifdef VSP_FIXED_POINT
+    const float cpu_scale = 2.0 / 32768;
+#else
+    const float cpu_scale = 2.0 / N;
+#endif
+    float peak = 0.0, error = 0.0;
+
+    for (int k = 0; k <= M; ++k)
+    {
+        const float cpu = cpu_scale * hypotf(sa->freq_bins[k].r, sa->freq_bins[k].i);
+        const float gpu = 2.0 / N * hypotf(bins[2 * k], bins[2 * k + 1]);
+
+        peak = fmaxf(peak, cpu);
+        error = fmaxf(error, fabsf(cpu - gpu));
+    }
+
+    free(signal);
+    free(bins);
+
+    return peak > 0.0 ? error / peak : INFINITY;
+}
+
+static double
+now_us (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+void
+gpu_fft_benchmark (struct gpu_fft *gf,
+                   struct spectrum_analyzer *sa,
+                   int iterations,
+                   double *cpu_us,
+                   double *gpu_us)
+{
+    const int N = gf->window_size;
+
+    kiss_fft_scalar *signal = malloc(N * sizeof(kiss_fft_scalar));
+    if (!signal)
+    {
+        *cpu_us = *gpu_us = NAN;
+        return;
+    }
+
+    test_signal(signal, N);
+
+    double start = now_us();
+    for (int i = 0; i < iterations; ++i)
+    {
+        memcpy(sa->sample_win, signal, N * sizeof(kiss_fft_scalar));
+        sa_transform(sa);
+    }
+    *cpu_us = (now_us() - start) / iterations;
+
+    // Once to warm up, so that shader compilation and first-use costs stay out.
+    gpu_fft_process(gf, signal);
+    glFinish();
+
+    start = now_us();
+    for (int i = 0; i < iterations; ++i)
+        gpu_fft_process(gf, signal);
+    glFinish();
+    *gpu_us = (now_us() - start) / iterations;
+
+    free(signal);
+}
+
+void
+gpu_fft_deinit (struct gpu_fft *gf)
+{
+    glDeleteTextures(1, &gf->samples_texture);
+    glDeleteBuffers(1, &gf->samples_buffer);
+    glDeleteBuffers(2, gf->work_buffer);
+    glDeleteBuffers(1, &gf->bins_buffer);
+    glDeleteBuffers(1, &gf->hann_buffer);
+    glDeleteBuffers(1, &gf->twiddle_buffer);
+    glDeleteProgram(gf->post_program);
+    glDeleteProgram(gf->stage_program);
+    glDeleteProgram(gf->shared_program);
+}
@@ -0,0 +1,66 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "gl.h"
+
+struct spectrum_analyzer;
+
+// Real FFT of a tapered window as GL 4.3 compute shaders (Stockham, radix-4 with
+// a final radix-2 pass where needed). The result is laid out like kiss_fftr()'s,
+// window_size/2 + 1 complex (vec2) bins, in bins_buffer; nothing is read back.
+struct gpu_fft
+{
+    int window_size;
+    // Whether the whole transform fits one workgroup's shared memory.
+    int shared;
+    GLenum sample_format;
+
+    GLuint samples_buffer, samples_texture;
+    GLuint twiddle_buffer, hann_buffer;
+    GLuint work_buffer[2];
+    GLuint bins_buffer;
+
+    GLuint shared_program, stage_program, post_program;
+    GLint ns_location, radix_location, first_location;
+};
+
+// Needs a power-of-two window and compute shaders (GL 4.3 or the ARB extensions);
+// <0 if either is missing. Samples come in `sample_format`: GL_R32F, or GL_R16I
+// for Q15.
+int
+gpu_fft_init (struct gpu_fft *gf, int window_size, GLenum sample_format);
+
+// Uploads the untapered `samples`, and queues the transform into bins_buffer.
+void
+gpu_fft_process (struct gpu_fft *gf, const void *samples);
+
+// Transforms a test signal on both `sa` and `gf`, and returns the largest
+// deviation between their band levels (2|X|/N), relative to the peak level.
+// Clobbers sa->sample_win and sa->freq_bins.
+float
+gpu_fft_check (struct gpu_fft *gf, struct spectrum_analyzer *sa);
+
+// Average time per transform, in microseconds, for `sa` and for `gf` (upload
+// and dispatch, until finished) over `iterations` runs.
+void
+gpu_fft_benchmark (struct gpu_fft *gf,
+                   struct spectrum_analyzer *sa,
+                   int iterations,
+                   double *cpu_us,
+                   double *gpu_us);
+
+void
+gpu_fft_deinit (struct gpu_fft *gf);
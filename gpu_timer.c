@@ -0,0 +1,194 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "gpu_timer.h"
+
+// Reads back whatever results have come in, oldest first.
+static void
+gt_collect (struct gpu_timer* gt)
+{
+    while (gt->pending > 0)
+    {
+        const GLuint* frame = gt->queries[gt->first];
+        GLuint available = GL_FALSE;
+
+        // The end comes back last.
+        glGetQueryObjectuiv(frame[gt->num_stages], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            break;
+
+        GLuint64 stamps[GT_MAX_STAGES + 1];
+        for (int i = 0; i <= gt->num_stages; ++i)
+            glGetQueryObjectui64v(frame[i], GL_QUERY_RESULT, &stamps[i]);
+
+        for (int i = 0; i < gt->num_stages; ++i)
+        {
+            gt->history[i][gt->next] = (stamps[i + 1] - stamps[i]) * 1e-6;
+            gt->sums[i] += (stamps[i + 1] - stamps[i]) * 1e-6;
+        }
+
+        const double total = (stamps[gt->num_stages] - stamps[0]) * 1e-6;
+        gt->history[gt->num_stages][gt->next] = total;
+        gt->next = (gt->next + 1) % GT_HISTORY;
+        gt->filled += gt->filled < GT_HISTORY;
+
+        gt->count += 1;
+
+        gt->first = (gt->first + 1) % GT_QUERIES;
+        gt->pending -= 1;
+    }
+}
+
+int
+gt_init (struct gpu_timer* gt, const char* const* names, int num_stages)
+{
+    if (num_stages < 1 || num_stages > GT_MAX_STAGES)
+        return -1;
+
+    glGenQueries(GT_QUERIES * (GT_MAX_STAGES + 1), &gt->queries[0][0]);
+
+    gt->num_stages = num_stages;
+    gt->names = names;
+    gt->first = 0;
+    gt->pending = 0;
+    gt->marks = 0;
+    gt->next = 0;
+    gt->filled = 0;
+    memset(gt->sums, 0, sizeof gt->sums);
+    gt->count = 0;
+
+    return 0;
+}
+
+void
+gt_begin (struct gpu_timer* gt)
+{
+    gt_collect(gt);
+
+    // Every query still out; this frame goes untimed rather than waiting.
+    if (gt->pending == GT_QUERIES)
+        return;
+
+    glQueryCounter(gt->queries[(gt->first + gt->pending) % GT_QUERIES][0], GL_TIMESTAMP);
+    gt->marks = 1;
+}
+
+void
+gt_mark (struct gpu_timer* gt)
+{
+    if (gt->marks == 0 || gt->marks == gt->num_stages)
+        return;
+
+    glQueryCounter(gt->queries[(gt->first + gt->pending) % GT_QUERIES][gt->marks], GL_TIMESTAMP);
+    gt->marks += 1;
+}
+
+void
+gt_end (struct gpu_timer* gt)
+{
+    if (gt->marks == 0)
+        return;
+
+    // Stages skipped this frame end where they begin.
+    const GLuint* frame = gt->queries[(gt->first + gt->pending) % GT_QUERIES];
+    for (; gt->marks <= gt->num_stages; ++gt->marks)
+        glQueryCounter(frame[gt->marks], GL_TIMESTAMP);
+
+    gt->pending += 1;
+    gt->marks = 0;
+}
+
+void
+gt_reset (struct gpu_timer* gt)
+{
+    // Their queries are simply issued again; GL drops the results never read.
+    gt->first = (gt->first + gt->pending) % GT_QUERIES;
+    gt->pending = 0;
+
+    memset(gt->sums, 0, sizeof gt->sums);
+    gt->count = 0;
+}
+
+double
+gt_mean (struct gpu_timer* gt, int first, int end)
+{
+    gt_collect(gt);
+
+    double sum = 0.0;
+    for (int i = first; i < end; ++i)
+        sum += gt->sums[i];
+
+    const double mean = gt->count ? sum / gt->count : -1.0;
+
+    memset(gt->sums, 0, sizeof gt->sums);
+    gt->count = 0;
+
+    return mean;
+}
+
+static int
+compare_floats (const void* a, const void* b)
+{
+    const float x = *(const float*)a, y = *(const float*)b;
+
+    return (x > y) - (x < y);
+}
+
+double
+gt_percentile (struct gpu_timer* gt, int stage, double p)
+{
+    float sorted[GT_HISTORY];
+
+    gt_collect(gt);
+
+    if (gt->filled == 0)
+        return -1.0;
+
+    // Every frame in the history is still in there, whatever order.
+    memcpy(sorted, gt->history[stage], gt->filled * sizeof(float));
+    qsort(sorted, gt->filled, sizeof(float), compare_floats);
+
+    // Nearest rank.
+    int rank = (int)(p / 100.0 * gt->filled + 0.5) - 1;
+    rank = rank < 0 ? 0 : rank >= gt->filled ? gt->filled - 1 : rank;
+
+    return sorted[rank];
+}
+
+void
+gt_report (struct gpu_timer* gt, FILE* f)
+{
+    if (gt_percentile(gt, gt->num_stages, 50.0) < 0.0)
+        return;
+
+    fprintf(f, "GPU time over %d frames, in ms (p50 / p95 / p99):\n", gt->filled);
+
+    for (int i = 0; i <= gt->num_stages; ++i)
+        fprintf(f, "  %-10s %7.3f / %7.3f / %7.3f\n",
+                i < gt->num_stages ? gt->names[i] : "total",
+                gt_percentile(gt, i, 50.0),
+                gt_percentile(gt, i, 95.0),
+                gt_percentile(gt, i, 99.0));
+}
+
+void
+gt_deinit (struct gpu_timer* gt)
+{
+    glDeleteQueries(GT_QUERIES * (GT_MAX_STAGES + 1), &gt->queries[0][0]);
+}
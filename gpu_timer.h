@@ -0,0 +1,89 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+
+#include "gl.h"
+
+// Queries in flight; results are read this many frames late at most.
+#define GT_QUERIES 4
+// Most stages a frame can be split into.
+#define GT_MAX_STAGES 8
+// Frames the percentiles are taken over; 4 s at 60 fps.
+#define GT_HISTORY 240
+
+// GPU time spent on the commands between gt_begin() and gt_end(), split into
+// stages by gt_mark(), and read back once the GPU is done with them, so that
+// nothing ever waits on it. Each boundary is a GL_TIMESTAMP query, so a stage
+// also takes in any time the GPU spent idle waiting for its commands.
+struct gpu_timer
+{
+    int num_stages;
+    const char* const* names;
+
+    GLuint queries[GT_QUERIES][GT_MAX_STAGES + 1];
+    // Oldest frame not yet read back, and how many are out.
+    int first, pending;
+    // Boundaries timed so far in the running frame; 0 if gt_begin() didn't
+    // start one, which it doesn't with every query out.
+    int marks;
+
+    // The last GT_HISTORY frames, per stage and then in total, in ms.
+    float history[GT_MAX_STAGES + 1][GT_HISTORY];
+    int next, filled;
+
+    // Sums of each stage read back since the last gt_mean().
+    double sums[GT_MAX_STAGES];
+    int count;
+};
+
+// `names` has a name for each of the `num_stages` stages, and has to outlive
+// the timer.
+int
+gt_init (struct gpu_timer* gt, const char* const* names, int num_stages);
+
+void
+gt_begin (struct gpu_timer* gt);
+
+// Ends the stage running, and starts the next.
+void
+gt_mark (struct gpu_timer* gt);
+
+// Ends the last stage, and the frame; stages not marked take no time.
+void
+gt_end (struct gpu_timer* gt);
+
+// Drops the frames not read back yet, and what gt_mean() has summed so far;
+// for when the frames in flight no longer stand for what's drawn.
+void
+gt_reset (struct gpu_timer* gt);
+
+// Mean time of stages `first` to `end` - 1 together, over the frames read
+// back since the last call, in ms; <0 if there were none.
+double
+gt_mean (struct gpu_timer* gt, int first, int end);
+
+// The p-th percentile (0-100) of a stage over the last GT_HISTORY frames, in
+// ms; the whole frame for `stage` = num_stages. <0 with nothing read back yet.
+double
+gt_percentile (struct gpu_timer* gt, int stage, double p);
+
+// Writes the median, 95th and 99th percentile of every stage and the total.
+void
+gt_report (struct gpu_timer* gt, FILE* f);
+
+void
+gt_deinit (struct gpu_timer* gt);
@@ -0,0 +1,181 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdio.h>
+#include <string.h>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include "headless.h"
+
+// A 1x1 pbuffer on `hc->display`, for a context that has to be made with a
+// config.
+static int
+hc_open_pbuffer (struct headless_context* hc)
+{
+    static const EGLint config_attribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    static const EGLint pbuffer_attribs[] = {
+        EGL_WIDTH, 1,
+        EGL_HEIGHT, 1,
+        EGL_NONE
+    };
+
+    EGLConfig config;
+    EGLint num_configs = 0;
+
+    if (!eglChooseConfig(hc->display, config_attribs, &config, 1, &num_configs) || num_configs < 1)
+        return -1;
+
+    hc->surface = eglCreatePbufferSurface(hc->display, config, pbuffer_attribs);
+
+    return hc->surface != EGL_NO_SURFACE ? 0 : -1;
+}
+
+// Surfaceless where Mesa offers it, which needs no GPU or display at all under
+// llvmpipe; a pbuffer on the default display otherwise. A surfaceless display
+// still gets a pbuffer if it can't make a context without a config.
+static int
+hc_open_display (struct headless_context* hc)
+{
+    const char* exts = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    if (exts && strstr(exts, "EGL_MESA_platform_surfaceless"))
+    {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC get_platform_display =
+            (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+        if (get_platform_display)
+            hc->display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+
+        if (hc->display && eglInitialize(hc->display, NULL, NULL))
+        {
+            const char* display_exts = eglQueryString(hc->display, EGL_EXTENSIONS);
+
+            if (display_exts && strstr(display_exts, "EGL_KHR_no_config_context"))
+                return 0;
+            if (hc_open_pbuffer(hc) == 0)
+                return 0;
+
+            eglTerminate(hc->display);
+        }
+    }
+
+    hc->display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (hc->display == EGL_NO_DISPLAY || !eglInitialize(hc->display, NULL, NULL))
+        return -1;
+
+    return hc_open_pbuffer(hc);
+}
+
+int
+hc_init (struct headless_context* hc, int major, int minor, int width, int height)
+{
+    *hc = (struct headless_context) { .width = width, .height = height };
+
+    if (hc_open_display(hc) < 0)
+    {
+        fputs("No EGL display to render on :(\n", stderr);
+        hc_deinit(hc);
+        return -1;
+    }
+
+    const EGLint context_attribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, major,
+        EGL_CONTEXT_MINOR_VERSION, minor,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+
+    eglBindAPI(EGL_OPENGL_API);
+
+    // Made without a config only when there's no pbuffer, which is when the
+    // display has EGL_KHR_no_config_context; with the pbuffer's config otherwise.
+    EGLConfig config = EGL_NO_CONFIG_KHR;
+    if (hc->surface)
+    {
+        EGLint id = 0;
+        EGLint num_configs = 0;
+        eglQuerySurface(hc->display, hc->surface, EGL_CONFIG_ID, &id);
+
+        const EGLint config_attribs[] = { EGL_CONFIG_ID, id, EGL_NONE };
+        eglChooseConfig(hc->display, config_attribs, &config, 1, &num_configs);
+    }
+
+    hc->context = eglCreateContext(hc->display, config, EGL_NO_CONTEXT, context_attribs);
+    if (hc->context != EGL_NO_CONTEXT &&
+        !eglMakeCurrent(hc->display, hc->surface, hc->surface, hc->context))
+    {
+        // Never current, so there's nothing of GL's to clean up.
+        eglDestroyContext(hc->display, hc->context);
+        hc->context = EGL_NO_CONTEXT;
+    }
+
+    if (hc->context == EGL_NO_CONTEXT)
+    {
+        hc_deinit(hc);
+        return -1;
+    }
+
+    if (!gladLoadGL((GLADloadfunc)eglGetProcAddress))
+    {
+        fputs("Couldn't load the OpenGL functions :(\n", stderr);
+        hc_deinit(hc);
+        return -1;
+    }
+
+    glGenFramebuffers(1, &hc->fbo);
+    glGenRenderbuffers(1, &hc->color);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, hc->color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindFramebuffer(GL_FRAMEBUFFER, hc->fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, hc->color);
+
+    // A window's framebuffer starts out bound, and with the viewport over it.
+    glViewport(0, 0, width, height);
+
+    return 0;
+}
+
+void
+hc_deinit (struct headless_context* hc)
+{
+    if (hc->context)
+    {
+        // Only once GL was loaded, and they were made.
+        if (hc->fbo)
+        {
+            glDeleteFramebuffers(1, &hc->fbo);
+            glDeleteRenderbuffers(1, &hc->color);
+        }
+
+        eglMakeCurrent(hc->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext(hc->display, hc->context);
+    }
+
+    if (hc->surface)
+        eglDestroySurface(hc->display, hc->surface);
+
+    if (hc->display)
+        eglTerminate(hc->display);
+
+    *hc = (struct headless_context) { 0 };
+}
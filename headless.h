@@ -0,0 +1,36 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "gl.h"
+
+// An OpenGL core context with no window or display server behind it, through
+// EGL; frames are drawn into `fbo`, which stands in for the window's.
+struct headless_context
+{
+    // EGLDisplay, EGLSurface and EGLContext; the surface is a 1x1 pbuffer
+    // where EGL_MESA_platform_surfaceless isn't there, and NULL where it is.
+    void *display, *surface, *context;
+
+    GLuint fbo, color;
+    int width, height;
+};
+
+// Makes the context current and loads OpenGL through it.
+int
+hc_init (struct headless_context* hc, int major, int minor, int width, int height);
+
+void
+hc_deinit (struct headless_context* hc);
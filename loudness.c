@@ -0,0 +1,236 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <math.h>
+#include <string.h>
+
+#include "loudness.h"
+
+#define MOMENTARY_SUBBLOCKS 4
+#define ABSOLUTE_GATE -70.0
+#define RELATIVE_GATE -10.0
+#define HISTOGRAM_STEP 0.1
+#define PHASES 4
+
+static inline double
+energy_to_lufs (double ms)
+{
+    return -0.691 + 10.0 * log10(ms);
+}
+
+// K-weighting filters for an arbitrary sample rate, after ITU-R BS.1770 (the
+// 48 kHz coefficients in the standard are the bilinear transforms of these).
+static void
+k_weighting (struct loudness_meter *m, double fs)
+{
+    double f0 = 1681.974450955533;
+    double Q = 0.7071752369554196;
+    double K = tan(M_PI * f0 / fs);
+
+    const double G = 3.999843853973347;
+    const double Vh = pow(10.0, G / 20.0);
+    const double Vb = pow(Vh, 0.4996667741545416);
+    double a0 = 1.0 + K / Q + K * K;
+
+    m->shelf = (struct loudness_biquad) {
+        .b0 = (Vh + Vb * K / Q + K * K) / a0,
+        .b1 = 2.0 * (K * K - Vh) / a0,
+        .b2 = (Vh - Vb * K / Q + K * K) / a0,
+        .a1 = 2.0 * (K * K - 1.0) / a0,
+        .a2 = (1.0 - K / Q + K * K) / a0,
+    };
+
+    f0 = 38.13547087602444;
+    Q = 0.5003270373238773;
+    K = tan(M_PI * f0 / fs);
+    a0 = 1.0 + K / Q + K * K;
+
+    m->highpass = (struct loudness_biquad) {
+        .b0 = 1.0,
+        .b1 = -2.0,
+        .b2 = 1.0,
+        .a1 = 2.0 * (K * K - 1.0) / a0,
+        .a2 = (1.0 - K / Q + K * K) / a0,
+    };
+}
+
+// Blackman-windowed sinc interpolator, split into 4 phases of unity gain. The
+// prototype has L + 1 taps, centred on one, and its last (zero) is dropped; so
+// phase 0 is the identity, and the sample instants themselves are among those
+// the peak is taken over, which keeps true-peak at or above the sample peak.
+static void
+true_peak_filter (struct loudness_meter *m)
+{
+    const int L = PHASES * LOUDNESS_TRUE_PEAK_TAPS;
+    float h[PHASES * LOUDNESS_TRUE_PEAK_TAPS];
+    float sum[PHASES] = {0};
+
+    for (int n = 0; n < L; ++n)
+    {
+        const double t = (double)(n - PHASES * (LOUDNESS_TRUE_PEAK_TAPS / 2)) / PHASES;
+        const double w = 0.42 - 0.5 * cos(2 * M_PI * n / L) + 0.08 * cos(4 * M_PI * n / L);
+
+        h[n] = w * (t == 0 ? 1.0 : sin(M_PI * t) / (M_PI * t));
+        sum[n % PHASES] += h[n];
+    }
+
+    // taps[j] multiplies the j-th oldest sample, i.e. a delay of TAPS - 1 - j.
+    for (int j = 0; j < LOUDNESS_TRUE_PEAK_TAPS; ++j)
+        for (int p = 0; p < PHASES; ++p)
+            m->taps[j][p] = h[p + PHASES * (LOUDNESS_TRUE_PEAK_TAPS - 1 - j)] / sum[p];
+}
+
+void
+loudness_init (struct loudness_meter *m, uint32_t sample_rate)
+{
+    memset(m, 0, sizeof *m);
+
+    k_weighting(m, sample_rate);
+    true_peak_filter(m);
+
+    m->subblock_len = sample_rate / 10;
+
+    atomic_init(&m->momentary, -INFINITY);
+    atomic_init(&m->short_term, -INFINITY);
+    atomic_init(&m->integrated, -INFINITY);
+    atomic_init(&m->true_peak, -INFINITY);
+    atomic_init(&m->updates, 0);
+}
+
+// Mean energy of the blocks at or above `gate` (to within a bin); 0 if there are none.
+static double
+histogram_mean (const struct loudness_meter *m, double gate)
+{
+    int first = (gate - ABSOLUTE_GATE) / HISTOGRAM_STEP;
+    double sum = 0.0;
+    uint64_t count = 0;
+
+    for (int b = first < 0 ? 0 : first; b < LOUDNESS_HISTOGRAM_BINS; ++b)
+    {
+        sum += m->histogram_energy[b];
+        count += m->histogram[b];
+    }
+
+    return count ? sum / count : 0.0;
+}
+
+static double
+subblock_mean (const struct loudness_meter *m, int n)
+{
+    double sum = 0.0;
+
+    for (int i = 1; i <= n; ++i)
+        sum += m->subblocks[(m->subblock_pos - i + LOUDNESS_SHORT_TERM_SUBBLOCKS)
+                            % LOUDNESS_SHORT_TERM_SUBBLOCKS];
+
+    return sum / n;
+}
+
+static void
+loudness_end_subblock (struct loudness_meter *m)
+{
+    m->subblocks[m->subblock_pos] = m->subblock_sum / m->subblock_len;
+    m->subblock_pos = (m->subblock_pos + 1) % LOUDNESS_SHORT_TERM_SUBBLOCKS;
+    m->subblock_count++;
+
+    m->subblock_sum = 0.0;
+    m->subblock_fill = 0;
+
+    // Gating blocks are 400 ms long and start every 100 ms (75% overlap).
+    if (m->subblock_count >= MOMENTARY_SUBBLOCKS)
+    {
+        const double energy = subblock_mean(m, MOMENTARY_SUBBLOCKS);
+        const double momentary = energy_to_lufs(energy);
+
+        if (momentary >= ABSOLUTE_GATE)
+        {
+            int b = (momentary - ABSOLUTE_GATE) / HISTOGRAM_STEP;
+            b = b < LOUDNESS_HISTOGRAM_BINS ? b : LOUDNESS_HISTOGRAM_BINS - 1;
+
+            m->histogram[b]++;
+            m->histogram_energy[b] += energy;
+        }
+
+        atomic_store_explicit(&m->momentary, momentary, memory_order_relaxed);
+    }
+
+    if (m->subblock_count >= LOUDNESS_SHORT_TERM_SUBBLOCKS)
+        atomic_store_explicit(&m->short_term,
+                              energy_to_lufs(subblock_mean(m, LOUDNESS_SHORT_TERM_SUBBLOCKS)),
+                              memory_order_relaxed);
+
+    const double absolute = histogram_mean(m, ABSOLUTE_GATE);
+    if (absolute > 0.0)
+    {
+        const double relative = histogram_mean(m, energy_to_lufs(absolute) + RELATIVE_GATE);
+        atomic_store_explicit(&m->integrated, energy_to_lufs(relative), memory_order_relaxed);
+    }
+
+    atomic_store_explicit(&m->true_peak, 10.0 * log10f(m->peak), memory_order_relaxed);
+    atomic_fetch_add_explicit(&m->updates, 1, memory_order_release);
+}
+
+static inline float
+biquad_step (struct loudness_biquad *restrict bq, float x)
+{
+    // Transposed direct form II.
+    const float y = bq->b0 * x + bq->z1;
+
+    bq->z1 = bq->b1 * x - bq->a1 * y + bq->z2;
+    bq->z2 = bq->b2 * x - bq->a2 * y;
+
+    return y;
+}
+
+static inline void
+loudness_feed (struct loudness_meter *restrict m, float x)
+{
+    const float k = biquad_step(&m->highpass, biquad_step(&m->shelf, x));
+
+    m->subblock_sum += k * k;
+
+    // All four interpolation phases at once, one per lane.
+    m->history[m->history_pos] = x;
+    m->history[m->history_pos + LOUDNESS_TRUE_PEAK_TAPS] = x;
+    m->history_pos = (m->history_pos + 1) % LOUDNESS_TRUE_PEAK_TAPS;
+
+    const float *w = &m->history[m->history_pos];
+    loudness_v4f y = {0};
+
+    for (int j = 0; j < LOUDNESS_TRUE_PEAK_TAPS; ++j)
+        y += w[j] * m->taps[j];
+
+    // Squared; the square root is taken in dB.
+    y *= y;
+    m->peak = fmaxf(m->peak, fmaxf(fmaxf(y[0], y[1]), fmaxf(y[2], y[3])));
+
+    if (++m->subblock_fill == m->subblock_len)
+        loudness_end_subblock(m);
+}
+
+void
+loudness_process (struct loudness_meter *m, const float *samples, size_t len)
+{
+    for (size_t i = 0; i < len; ++i)
+        loudness_feed(m, samples[i]);
+}
+
+void
+loudness_process_s16 (struct loudness_meter *m, const int16_t *samples, size_t len)
+{
+    for (size_t i = 0; i < len; ++i)
+        loudness_feed(m, samples[i] * (1.0f / 32768));
+}
@@ -0,0 +1,77 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+// 100 ms gating sub-blocks; a momentary block is 4 of them, a short-term one 30.
+#define LOUDNESS_SHORT_TERM_SUBBLOCKS 30
+// Histogram of gating-block loudness for the integrated measurement; 0.1 LU
+// bins from the absolute gate (-70 LUFS) up to +5 LUFS.
+#define LOUDNESS_HISTOGRAM_BINS 750
+// Taps per phase of the 4× oversampling filter for true-peak.
+#define LOUDNESS_TRUE_PEAK_TAPS 12
+
+typedef float loudness_v4f __attribute__((vector_size(16)));
+
+struct loudness_biquad
+{
+    float b0, b1, b2, a1, a2;
+    float z1, z2;
+};
+
+struct loudness_meter
+{
+    // K-weighting; a high shelf followed by the RLB high-pass.
+    struct loudness_biquad shelf, highpass;
+
+    int subblock_len;
+    int subblock_fill;
+    double subblock_sum;
+
+    // Mean squares of the latest sub-blocks, as a ring.
+    double subblocks[LOUDNESS_SHORT_TERM_SUBBLOCKS];
+    int subblock_pos;
+    int subblock_count;
+
+    // Block counts and summed block energies, per bin.
+    uint32_t histogram[LOUDNESS_HISTOGRAM_BINS];
+    double histogram_energy[LOUDNESS_HISTOGRAM_BINS];
+
+    // Polyphase taps (one phase per lane), oldest tap first, and the input
+    // history, stored twice over so that the latest taps are always contiguous.
+    loudness_v4f taps[LOUDNESS_TRUE_PEAK_TAPS];
+    float history[2 * LOUDNESS_TRUE_PEAK_TAPS];
+    int history_pos;
+    float peak;
+
+    // Published at every sub-block for other threads; LUFS, and dBTP.
+    _Atomic float momentary;
+    _Atomic float short_term;
+    _Atomic float integrated;
+    _Atomic float true_peak;
+    _Atomic unsigned updates;
+};
+
+void
+loudness_init (struct loudness_meter *m, uint32_t sample_rate);
+
+void
+loudness_process (struct loudness_meter *m, const float *samples, size_t len);
+
+void
+loudness_process_s16 (struct loudness_meter *m, const int16_t *samples, size_t len);
@@ -0,0 +1,236 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <math.h>
+#include <complex.h>
+
+#include "arena.h"
+#include "onset.h"
+
+// Tempo range the tracker locks onto, and the tempo it leans towards.
+static const float ONSET_MIN_BPM = 60.0;
+static const float ONSET_MAX_BPM = 200.0;
+static const float ONSET_PREFERRED_BPM = 120.0;
+// Compression applied to magnitudes before differencing; keeps the bass from
+// drowning out everything else.
+static const float LOG_GAMMA = 100.0;
+// Adaptive threshold: THRESHOLD_DELTA + THRESHOLD_RATIO × (mean flux over THRESHOLD_SECONDS).
+static const float THRESHOLD_SECONDS = 0.5;
+static const float THRESHOLD_RATIO = 1.5;
+static const float THRESHOLD_DELTA = 0.002;
+// Onsets closer than this are merged into the first one.
+static const float MIN_ONSET_GAP = 0.05;
+// Memory of the tempo autocorrelation.
+static const float ACF_SECONDS = 6.0;
+// How far each onset pulls the beat phase towards itself.
+static const float PHASE_GAIN = 0.2;
+
+static void
+onset_sizes (int window_size, int sample_rate, int *flux_len, int *lag_min, int *lag_max)
+{
+    const float hop_rate = 2.0f * sample_rate / window_size;
+
+    *flux_len = ceilf(THRESHOLD_SECONDS * hop_rate) + 2;
+    *lag_min = fmaxf(1.0, floorf(60.0 * hop_rate / ONSET_MAX_BPM));
+    *lag_max = fmaxf(*lag_min + 2, ceilf(60.0 * hop_rate / ONSET_MIN_BPM));
+}
+
+size_t
+onset_footprint (int window_size, int sample_rate)
+{
+    int flux_len, lag_min, lag_max;
+    onset_sizes(window_size, sample_rate, &flux_len, &lag_min, &lag_max);
+
+    return ARENA_ROUND((window_size / 2 + 1) * sizeof(float))
+         + ARENA_ROUND(flux_len * sizeof(float))
+         + 2 * ARENA_ROUND((lag_max + 1) * sizeof(float));
+}
+
+int
+onset_init (struct onset_detector *od,
+            struct arena *arena,
+            int window_size,
+            int sample_rate)
+{
+    onset_sizes(window_size, sample_rate, &od->flux_len, &od->lag_min, &od->lag_max);
+
+    od->fft_size = window_size / 2 + 1;
+#ifdef VSP_FIXED_POINT
+    // Fixed-point bins come out of KissFFT already scaled by 1/N.
+    od->mag_scale = 2.0 / 32768;
+#else
+    od->mag_scale = 2.0 / window_size;
+#endif
+    od->hop_rate = 2.0f * sample_rate / window_size;
+
+    od->prev_mag = arena_alloc(arena, od->fft_size * sizeof(float));
+    od->flux = arena_alloc(arena, od->flux_len * sizeof(float));
+    od->env = arena_alloc(arena, (od->lag_max + 1) * sizeof(float));
+    od->acf = arena_alloc(arena, (od->lag_max + 1) * sizeof(float));
+
+    if (!od->prev_mag || !od->flux || !od->env || !od->acf)
+        return -1;
+
+    od->flux_pos = 0;
+    od->env_pos = 0;
+    od->last_onset = -INFINITY;
+    od->period = 60.0 * od->hop_rate / ONSET_PREFERRED_BPM;
+    od->phase = 0.0;
+    od->hops = 0;
+
+    return 0;
+}
+
+// The strongest autocorrelation lag, weighted towards ONSET_PREFERRED_BPM and
+// refined to a fraction of a hop; 0 if there is no periodicity yet.
+static float
+onset_estimate_period (struct onset_detector *od)
+{
+    float best = 0.0;
+    int best_lag = 0;
+
+    for (int lag = od->lag_min; lag <= od->lag_max; ++lag)
+    {
+        const float octaves = log2f(60.0 * od->hop_rate / lag / ONSET_PREFERRED_BPM);
+        const float score = od->acf[lag] * expf(-0.5 * octaves * octaves);
+
+        if (score > best)
+        {
+            best = score;
+            best_lag = lag;
+        }
+    }
+
+    if (best_lag <= od->lag_min || best_lag >= od->lag_max)
+        return best_lag;
+
+    const float y0 = od->acf[best_lag - 1], y1 = od->acf[best_lag], y2 = od->acf[best_lag + 1];
+    const float denom = y0 - 2 * y1 + y2;
+
+    return denom < 0 ? best_lag + 0.5 * (y0 - y2) / denom : best_lag;
+}
+
+static int
+onset_step (struct onset_detector *od,
+            float flux,
+            double time,
+            bool analysed,
+            struct onset_event *events)
+{
+    const float hop_dt = 1.0 / od->hop_rate;
+    const int window = od->flux_len - 2;
+    int n = 0;
+
+    float mean = 0.0;
+    for (int i = 1; i <= window; ++i)
+        mean += od->flux[(od->flux_pos - i + od->flux_len) % od->flux_len];
+    mean /= window;
+
+    // The previous hop is an onset if it peaks over the threshold; this costs
+    // one hop of latency, but needs no look-ahead.
+    const float threshold = THRESHOLD_DELTA + THRESHOLD_RATIO * mean;
+    const float prev = od->flux[(od->flux_pos - 1 + od->flux_len) % od->flux_len];
+    const float prev2 = od->flux[(od->flux_pos - 2 + od->flux_len) % od->flux_len];
+    const double prev_time = time - hop_dt;
+    bool onset = false;
+
+    // (The first analysed hop is differenced against silence, so it can't count.)
+    if (analysed && od->hops >= 2 && prev > threshold && prev > prev2 && prev >= flux &&
+        prev_time - od->last_onset >= MIN_ONSET_GAP)
+    {
+        events[n++] = (struct onset_event) { ONSET_EVENT_ONSET, prev_time, prev - threshold };
+        od->last_onset = prev_time;
+        onset = true;
+    }
+
+    od->flux[od->flux_pos] = flux;
+    od->flux_pos = (od->flux_pos + 1) % od->flux_len;
+
+    // Onset strength envelope; the flux above its local mean.
+    const int env_len = od->lag_max + 1;
+    const float strength = fmaxf(flux - mean, 0.0);
+    const float decay = expf(-hop_dt / ACF_SECONDS);
+
+    od->env[od->env_pos] = strength;
+    for (int lag = od->lag_min; lag <= od->lag_max; ++lag)
+        od->acf[lag] = od->acf[lag] * decay + strength * od->env[(od->env_pos - lag + env_len) % env_len];
+    od->env_pos = (od->env_pos + 1) % env_len;
+    ++od->hops;
+
+    const float period = onset_estimate_period(od);
+    if (period > 0)
+        od->period = period;
+
+    // Beat phase; a phase-locked loop nudged by every onset.
+    od->phase += 1.0 / od->period;
+
+    if (onset)
+    {
+        float err = od->phase - 1.0 / od->period;
+        err -= roundf(err);
+        od->phase -= PHASE_GAIN * err;
+    }
+
+    if (od->phase >= 1.0)
+    {
+        od->phase -= floorf(od->phase);
+
+        // Only once the autocorrelation has seen a couple of periods.
+        if (period > 0 && od->hops > 2 * od->lag_max)
+            events[n++] = (struct onset_event) {
+                ONSET_EVENT_BEAT,
+                time - od->phase * od->period * hop_dt,
+                60.0 * od->hop_rate / od->period
+            };
+    }
+
+    return n;
+}
+
+int
+onset_process (struct onset_detector *od,
+               const kiss_fft_cpx *freq_bins,
+               double time,
+               int missed,
+               struct onset_event events[ONSET_MAX_EVENTS])
+{
+    struct onset_event dropped[ONSET_MAX_EVENTS];
+    const float hop_dt = 1.0 / od->hop_rate;
+
+    // Hops that went by unanalysed count as silence, which keeps the tempo
+    // estimate's time base uniform; their beats are stale by now anyway.
+    missed = missed < od->lag_max ? missed : od->lag_max;
+    for (int i = missed; i > 0; --i)
+        onset_step(od, 0.0, time - i * hop_dt, false, dropped);
+
+    // Half-wave rectified spectral flux.
+    float flux = 0.0;
+
+    for (int k = 0; k < od->fft_size; ++k)
+    {
+#ifdef VSP_FIXED_POINT
+        const float mag = hypotf(freq_bins[k].r, freq_bins[k].i);
+#else
+        const float mag = cabsf(*(complex float*)&freq_bins[k]);
+#endif
+        const float m = log1pf(LOG_GAMMA * od->mag_scale * mag);
+
+        flux += fmaxf(m - od->prev_mag[k], 0.0);
+        od->prev_mag[k] = m;
+    }
+
+    return onset_step(od, flux / od->fft_size, time, true, events);
+}
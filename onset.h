@@ -0,0 +1,86 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <kiss_fftr.h>
+
+struct arena;
+
+enum onset_event_type
+{
+    ONSET_EVENT_ONSET,
+    ONSET_EVENT_BEAT,
+};
+
+struct onset_event
+{
+    enum onset_event_type type;
+    // Stream time in seconds.
+    double time;
+    // Flux over the adaptive threshold for onsets; tempo in BPM for beats.
+    float value;
+};
+
+// At most one onset and one beat come out of a hop.
+#define ONSET_MAX_EVENTS 2
+
+struct onset_detector
+{
+    int fft_size;
+    float mag_scale;
+    float hop_rate;
+
+    // Log-magnitudes of the previous hop.
+    float *prev_mag;
+
+    // Recent flux, for the adaptive threshold and peak picking.
+    float *flux;
+    int flux_len;
+    int flux_pos;
+    double last_onset;
+
+    // Onset strength envelope and its leaky autocorrelation, over lags in hops.
+    float *env;
+    float *acf;
+    int lag_min, lag_max;
+    int env_pos;
+
+    // Beat period in hops and phase within it (0-1).
+    float period;
+    float phase;
+    int hops;
+};
+
+size_t
+onset_footprint (int window_size, int sample_rate);
+
+int
+onset_init (struct onset_detector *od,
+            struct arena *arena,
+            int window_size,
+            int sample_rate);
+
+// Feeds the spectrum of a hop ending at stream time `time`; `missed` is the
+// number of hops that went by unanalysed since the previous call. Returns the
+// number of events written to `events`.
+int
+onset_process (struct onset_detector *od,
+               const kiss_fft_cpx *freq_bins,
+               double time,
+               int missed,
+               struct onset_event events[ONSET_MAX_EVENTS]);
@@ -24,12 +24,13 @@
 #include <spa/pod/builder.h>
 #include <spa/param/audio/format-utils.h>
 
+#include "loudness.h"
 #include "pipewire.h"
 
 #define MIN(a, b) ((a) < (b) ? (a) : (b))
 
 static void
-pipewire_backend_store (struct pwb_sample_buffer* rb, float* samples, size_t len);
+pipewire_backend_store (struct pwb_sample_buffer* rb, pwb_sample* samples, size_t len);
 
 static void
 fill_audio_buffer(void *_userdata)
@@ -38,10 +39,18 @@ fill_audio_buffer(void *_userdata)
     struct pwb_sample_buffer *rb = &state->ring_buffer;
     struct pw_buffer *b = pw_stream_dequeue_buffer(state->stream);
 
-    float *samples = b->buffer->datas[0].data;
-    uint32_t n_samples = b->buffer->datas[0].chunk->size / sizeof(float);
+    pwb_sample *samples = b->buffer->datas[0].data;
+    uint32_t n_samples = b->buffer->datas[0].chunk->size / sizeof(pwb_sample);
 
     pipewire_backend_store(rb, samples, n_samples);
+
+    if (state->meter)
+#ifdef VSP_FIXED_POINT
+        loudness_process_s16(state->meter, samples, n_samples);
+#else
+        loudness_process(state->meter, samples, n_samples);
+#endif
+
     pw_stream_queue_buffer(state->stream, b);
 }
 
@@ -50,7 +59,7 @@ int
 pipewire_backend_init (struct pipewire_backend *backend,
                        struct pw_loop* loop,
                        const char* stream_name,
-                       int window_size,
+                       int ring_size,
                        int hop_size,
                        uint32_t sample_rate)
 {
@@ -73,13 +82,15 @@ pipewire_backend_init (struct pipewire_backend *backend,
                               PW_KEY_STREAM_CAPTURE_SINK, "true",
                               NULL);
 
-    backend->state.ring_buffer.capacity = window_size;
+    backend->state.ring_buffer.capacity = ring_size > PWB_MAX_QUANTUM ? ring_size : PWB_MAX_QUANTUM;
     backend->state.ring_buffer.cursor = 0;
+    backend->state.ring_buffer.written = 0;
 
-    backend->state.ring_buffer.buffer = calloc (window_size, sizeof(float));
+    backend->state.ring_buffer.buffer = calloc (backend->state.ring_buffer.capacity, sizeof(pwb_sample));
     if (!backend->state.ring_buffer.buffer)
         goto error;
 
+    backend->state.meter = NULL;
     backend->state.sample_rate = sample_rate;
     backend->state.stream = pw_stream_new_simple (loop,
                                                  stream_name,
@@ -114,7 +125,11 @@ pipewire_backend_connect (struct pipewire_backend *backend)
                                            &SPA_AUDIO_INFO_RAW_INIT(
                                                .channels = 1,
                                                .rate = backend->state.sample_rate,
+#ifdef VSP_FIXED_POINT
+                                               .format = SPA_AUDIO_FORMAT_S16
+#else
                                                .format = SPA_AUDIO_FORMAT_F32
+#endif
                                            ));
 
     return pw_stream_connect(backend->state.stream,
@@ -125,27 +140,41 @@ pipewire_backend_connect (struct pipewire_backend *backend)
                              1);
 }
 
-void
-pipewire_backend_capture(struct pipewire_backend *backend, float *samples)
+uint64_t
+pipewire_backend_capture(struct pipewire_backend *backend, pwb_sample *samples, size_t len)
 {
     struct pwb_sample_buffer *rb = &backend->state.ring_buffer;
 
-    size_t temp = rb->capacity - rb->cursor;
+    assert(len <= rb->capacity);
+
+    // The oldest of the samples wanted, and how many of them lie before the wrap.
+    const size_t start = (rb->cursor + rb->capacity - len) % rb->capacity;
+    const size_t temp = MIN(rb->capacity - start, len);
 
-    memcpy(samples, &rb->buffer[rb->cursor], temp * sizeof(float));
-    memcpy(&samples[temp], rb->buffer, rb->cursor * sizeof(float));
+    memcpy(samples, &rb->buffer[start], temp * sizeof(pwb_sample));
+    memcpy(&samples[temp], rb->buffer, (len - temp) * sizeof(pwb_sample));
+
+    return rb->written;
 }
 
 static void
-pipewire_backend_store (struct pwb_sample_buffer* rb, float* samples, size_t len)
+pipewire_backend_store (struct pwb_sample_buffer* rb, pwb_sample* samples, size_t len)
 {
-    // Assuming our circular buffer is larger than chunks of samples it recieves.
-    assert(len <= rb->capacity);
+    // Counted in full, whether or not all of it is kept.
+    rb->written += len;
+
+    // A quantum past PWB_MAX_QUANTUM (and the window) only has its latest
+    // samples kept; the rest would be overwritten anyway.
+    if (len > rb->capacity)
+    {
+        samples += len - rb->capacity;
+        len = rb->capacity;
+    }
 
     size_t temp = MIN(rb->capacity - rb->cursor, len);
 
-    memcpy(&rb->buffer[rb->cursor], samples, temp * sizeof(float));
-    memcpy(rb->buffer, &samples[temp], (len - temp) * sizeof(float));
+    memcpy(&rb->buffer[rb->cursor], samples, temp * sizeof(pwb_sample));
+    memcpy(rb->buffer, &samples[temp], (len - temp) * sizeof(pwb_sample));
 
     rb->cursor = (rb->cursor + len) % rb->capacity;
 }
@@ -20,17 +20,34 @@
 #include <pipewire/pipewire.h>
 #include <stdint.h>
 
+// Fixed-point builds capture S16 straight into the Q15 analysis path.
+#ifdef VSP_FIXED_POINT
+typedef int16_t pwb_sample;
+#else
+typedef float pwb_sample;
+#endif
+
+// Samples the ring holds at least, whatever the window: PipeWire's default
+// clock.max-quantum, so a whole quantum fits in even with a small window.
+#define PWB_MAX_QUANTUM 8192
+
 struct pwb_sample_buffer
 {
-    float* buffer;
+    pwb_sample* buffer;
     size_t capacity;
     size_t cursor;
+    // Samples stored since the stream started.
+    uint64_t written;
 };
 
+struct loudness_meter;
+
 struct pwb_state_carrier
 {
     struct pw_stream* stream;
     struct pwb_sample_buffer ring_buffer;
+    // Fed with every sample that passes through, if set.
+    struct loudness_meter* meter;
 
     uint32_t sample_rate;
 };
@@ -45,16 +62,19 @@ int
 pipewire_backend_init (struct pipewire_backend *backend,
                        struct pw_loop* loop,
                        const char* stream_name,
-                       int window_size,
+                       int ring_size,
                        int hop_size,
                        uint32_t sample_rate);
 
 int
 pipewire_backend_connect (struct pipewire_backend *backend);
 
-void
+// Copies out the latest `len` samples (at most `ring_size` as given to init);
+// returns the stream position (in samples) at their end.
+uint64_t
 pipewire_backend_capture(struct pipewire_backend *backend,
-                         float *sample_buf);
+                         pwb_sample *sample_buf,
+                         size_t len);
 
 void
 pipewire_backend_deinit (struct pipewire_backend *backend);
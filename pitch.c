@@ -0,0 +1,168 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <math.h>
+
+#include "arena.h"
+#include "pitch.h"
+
+// Range of fundamentals looked for.
+static const float PITCH_MIN_HZ = 40.0;
+static const float PITCH_MAX_HZ = 2000.0;
+// The first NSDF peak within this fraction of the highest one is taken.
+static const float PITCH_PEAK_RATIO = 0.9;
+// Below this, the window isn't considered periodic at all.
+static const float PITCH_MIN_CLARITY = 0.6;
+
+size_t
+pitch_footprint (int window_size)
+{
+    size_t ifft_len = 0;
+    kiss_fftr_alloc(window_size, 1, NULL, &ifft_len);
+
+    return ARENA_ROUND(ifft_len)
+         + ARENA_ROUND((window_size / 2 + 1) * sizeof(kiss_fft_cpx))
+         + ARENA_ROUND(window_size * sizeof(kiss_fft_scalar))
+         + ARENA_ROUND((window_size / 4 + 2) * sizeof(float));
+}
+
+int
+pitch_init (struct pitch_detector *pd,
+            struct arena *arena,
+            int window_size,
+            int sample_rate)
+{
+#ifdef VSP_FIXED_POINT
+    // A Q15 transform has no headroom for a power spectrum.
+    return -1;
+#endif
+
+    size_t ifft_len = 0;
+    kiss_fftr_alloc(window_size, 1, NULL, &ifft_len);
+
+    pd->window_size = window_size;
+    pd->sample_rate = sample_rate;
+
+    // The autocorrelation out of the FFT is circular; past a quarter of the
+    // window the wrapped-around part stops being negligible, Hann or not.
+    pd->min_lag = fmaxf(2.0, floorf(sample_rate / PITCH_MAX_HZ));
+    pd->max_lag = fminf(window_size / 4, ceilf(sample_rate / PITCH_MIN_HZ));
+
+    void *ifft_mem = arena_alloc(arena, ifft_len);
+    pd->power = arena_alloc(arena, (window_size / 2 + 1) * sizeof(kiss_fft_cpx));
+    pd->acf = arena_alloc(arena, window_size * sizeof(kiss_fft_scalar));
+    pd->nsdf = arena_alloc(arena, (window_size / 4 + 2) * sizeof(float));
+
+    if (!ifft_mem || !pd->power || !pd->acf || !pd->nsdf)
+        return -1;
+
+    pd->ifft = kiss_fftr_alloc(window_size, 1, ifft_mem, &ifft_len);
+    if (!pd->ifft)
+        return -1;
+
+    pd->frequency = 0.0;
+    pd->clarity = 0.0;
+
+    return 0;
+}
+
+void
+pitch_process (struct pitch_detector *pd,
+               const kiss_fft_scalar *samples,
+               const kiss_fft_cpx *freq_bins)
+{
+    const int N = pd->window_size;
+
+    // r(τ) = IFFT(|X|²); O(N log N) rather than O(N²).
+    for (int k = 0; k <= N / 2; ++k)
+    {
+        pd->power[k].r = freq_bins[k].r * freq_bins[k].r + freq_bins[k].i * freq_bins[k].i;
+        pd->power[k].i = 0.0;
+    }
+
+    kiss_fftri(pd->ifft, pd->power, pd->acf);
+
+    // m(τ) = Σ x[j]² + x[j+τ]² over the overlap; it shrinks by two squares per lag.
+    // KissFFT's inverse is unnormalised, hence the N on this side.
+    double m = 0.0;
+    for (int j = 0; j < N; ++j)
+        m += 2.0 * samples[j] * samples[j];
+
+    pd->frequency = 0.0;
+    pd->clarity = 0.0;
+
+    if (m <= 0.0)
+        return;
+
+    // Normalised square difference, n(τ) = 2 r(τ) / m(τ).
+    float *nsdf = pd->nsdf;
+    for (int tau = 0; tau <= pd->max_lag + 1; ++tau)
+    {
+        if (tau > 0)
+            m -= (double)samples[tau - 1] * samples[tau - 1]
+               + (double)samples[N - tau] * samples[N - tau];
+
+        nsdf[tau] = m > 0.0 ? 2.0 * pd->acf[tau] / (N * m) : 0.0;
+    }
+
+    // Key maxima: the highest point between each upward and downward zero crossing.
+    int keys[64], num_keys = 0;
+    float best = 0.0;
+
+    int tau = 1;
+    while (tau <= pd->max_lag && nsdf[tau] > 0.0)
+        ++tau;
+
+    while (tau <= pd->max_lag && num_keys < 64)
+    {
+        while (tau <= pd->max_lag && nsdf[tau] <= 0.0)
+            ++tau;
+
+        int peak = tau;
+        while (tau <= pd->max_lag && nsdf[tau] > 0.0)
+        {
+            if (nsdf[tau] > nsdf[peak])
+                peak = tau;
+            ++tau;
+        }
+
+        if (peak <= pd->max_lag && peak >= pd->min_lag)
+        {
+            keys[num_keys++] = peak;
+            best = fmaxf(best, nsdf[peak]);
+        }
+    }
+
+    for (int i = 0; i < num_keys; ++i)
+    {
+        const int k = keys[i];
+
+        if (nsdf[k] < PITCH_PEAK_RATIO * best)
+            continue;
+
+        if (nsdf[k] < PITCH_MIN_CLARITY)
+            return;
+
+        // Parabolic refinement of the lag.
+        const float a = nsdf[k - 1], b = nsdf[k], c = nsdf[k + 1];
+        const float denom = a - 2 * b + c;
+        const float offset = denom < 0 ? 0.5 * (a - c) / denom : 0.0;
+
+        pd->frequency = pd->sample_rate / (k + offset);
+        pd->clarity = b - 0.25 * (a - c) * offset;
+        return;
+    }
+}
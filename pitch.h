@@ -0,0 +1,56 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stddef.h>
+
+#include <kiss_fftr.h>
+
+struct arena;
+
+// McLeod pitch method, with the autocorrelation taken from the power spectrum
+// of the analysis FFT (Wiener-Khinchin) instead of a time-domain loop.
+struct pitch_detector
+{
+    int window_size;
+    int sample_rate;
+    int min_lag, max_lag;
+
+    kiss_fftr_cfg ifft;
+    kiss_fft_cpx *power;
+    kiss_fft_scalar *acf;
+    // Normalised square difference for lags up to max_lag + 1.
+    float *nsdf;
+
+    // Fundamental in Hz (0 if nothing periodic was found), and the normalised
+    // square difference at its lag (0-1), i.e. how clearly periodic the window is.
+    float frequency;
+    float clarity;
+};
+
+size_t
+pitch_footprint (int window_size);
+
+int
+pitch_init (struct pitch_detector *pd,
+            struct arena *arena,
+            int window_size,
+            int sample_rate);
+
+// `samples` is the tapered window the spectrum in `freq_bins` was taken of.
+void
+pitch_process (struct pitch_detector *pd,
+               const kiss_fft_scalar *samples,
+               const kiss_fft_cpx *freq_bins);
@@ -0,0 +1,253 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <errno.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "program_cache.h"
+
+// Leads every entry, before the binary itself.
+struct pc_header
+{
+    char magic[4];
+    GLenum format;
+    GLint length;
+};
+
+static const char PC_MAGIC[4] = { 'V', 'S', 'P', 'B' };
+
+static struct
+{
+    bool enabled;
+    char dir[PATH_MAX];
+    // Hash of the driver strings, that every key starts from.
+    uint64_t driver;
+    int hits, misses;
+} cache;
+
+// FNV-1a, over `len` bytes of `data` and the NUL after them, on top of `hash`.
+static uint64_t
+fnv1a (uint64_t hash, const char* data, size_t len)
+{
+    for (size_t i = 0; i <= len; ++i)
+    {
+        hash ^= i < len ? (unsigned char)data[i] : 0;
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
+static uint64_t
+fnv1a_str (uint64_t hash, const char* s)
+{
+    return fnv1a(hash, s ? s : "", s ? strlen(s) : 0);
+}
+
+// mkdir -p.
+static int
+make_dirs (char* path)
+{
+    for (char* p = path + 1; ; ++p)
+    {
+        if (*p != '/' && *p != '\0')
+            continue;
+
+        const char c = *p;
+        *p = '\0';
+        const int ret = mkdir(path, 0755);
+        *p = c;
+
+        if (ret != 0 && errno != EEXIST)
+            return -1;
+        if (c == '\0')
+            return 0;
+    }
+}
+
+static void
+entry_path (char* path, size_t size, uint64_t key)
+{
+    snprintf(path, size, "%s/%016llx", cache.dir, (unsigned long long)key);
+}
+
+int
+pc_init (const char* dir)
+{
+    cache.enabled = false;
+    cache.hits = cache.misses = 0;
+
+    if (!GLAD_GL_ARB_get_program_binary)
+        return -1;
+
+    // Drivers may take program binaries in, and still not give any out.
+    GLint num_formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &num_formats);
+    if (num_formats <= 0)
+        return -1;
+
+    if ((size_t)snprintf(cache.dir, sizeof cache.dir, "%s", dir) >= sizeof cache.dir)
+        return -1;
+
+    if (make_dirs(cache.dir) != 0)
+    {
+        perror(cache.dir);
+        return -1;
+    }
+
+    uint64_t hash = 0xcbf29ce484222325;
+    hash = fnv1a_str(hash, (const char*)glGetString(GL_VENDOR));
+    hash = fnv1a_str(hash, (const char*)glGetString(GL_RENDERER));
+    hash = fnv1a_str(hash, (const char*)glGetString(GL_VERSION));
+
+    cache.driver = hash;
+    cache.enabled = true;
+
+    return 0;
+}
+
+uint64_t
+pc_key (const char* const* sources, int num)
+{
+    uint64_t hash = cache.driver;
+
+    for (int i = 0; i < num; ++i)
+        hash = fnv1a_str(hash, sources[i]);
+
+    return hash;
+}
+
+GLuint
+pc_load (uint64_t key)
+{
+    if (!cache.enabled)
+        return 0;
+
+    char path[PATH_MAX + 32];
+    entry_path(path, sizeof path, key);
+
+    FILE* f = fopen(path, "rb");
+    if (!f)
+    {
+        cache.misses += 1;
+        return 0;
+    }
+
+    struct pc_header header;
+    void* binary = NULL;
+    GLuint program = 0;
+
+    if (fread(&header, sizeof header, 1, f) != 1 ||
+        memcmp(header.magic, PC_MAGIC, sizeof PC_MAGIC) != 0 || header.length <= 0)
+        goto stale;
+
+    binary = malloc(header.length);
+    if (!binary || fread(binary, header.length, 1, f) != 1)
+        goto stale;
+
+    program = glCreateProgram();
+    glProgramBinary(program, header.format, binary, header.length);
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked)
+        goto stale;
+
+    free(binary);
+    fclose(f);
+
+    cache.hits += 1;
+    return program;
+
+stale:
+    // Truncated, or turned down by the driver; it gets linked and stored anew.
+    if (program)
+        glDeleteProgram(program);
+    free(binary);
+    fclose(f);
+    unlink(path);
+
+    cache.misses += 1;
+    return 0;
+}
+
+void
+pc_prepare (GLuint program)
+{
+    if (cache.enabled)
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void
+pc_store (uint64_t key, GLuint program)
+{
+    if (!cache.enabled)
+        return;
+
+    GLint linked = GL_FALSE;
+    struct pc_header header;
+    memcpy(header.magic, PC_MAGIC, sizeof PC_MAGIC);
+
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &header.length);
+    if (!linked || header.length <= 0)
+        return;
+
+    void* binary = malloc(header.length);
+    if (!binary)
+        return;
+
+    glGetProgramBinary(program, header.length, &header.length, &header.format, binary);
+
+    // Written aside and renamed into place, so that a concurrent start never
+    // reads half an entry.
+    char path[PATH_MAX + 32], tmp[PATH_MAX + 64];
+    entry_path(path, sizeof path, key);
+    snprintf(tmp, sizeof tmp, "%s.%ld", path, (long)getpid());
+
+    FILE* f = fopen(tmp, "wb");
+    if (!f)
+    {
+        // Most likely a read-only cache; no point trying again for every program.
+        perror(tmp);
+        cache.enabled = false;
+        free(binary);
+        return;
+    }
+
+    const bool written = fwrite(&header, sizeof header, 1, f) == 1 &&
+                         fwrite(binary, header.length, 1, f) == 1;
+
+    if (fclose(f) == 0 && written)
+        rename(tmp, path);
+    else
+        unlink(tmp);
+
+    free(binary);
+}
+
+void
+pc_stats (int* hits, int* misses)
+{
+    *hits = cache.hits;
+    *misses = cache.misses;
+}
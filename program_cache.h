@@ -0,0 +1,51 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdint.h>
+
+#include "gl.h"
+
+// Linked programs kept across runs with glGetProgramBinary(), one file per
+// program. Entries are keyed by the driver (vendor, renderer and version
+// strings) and the sources, so an update of either just misses; nothing is
+// ever evicted. There's one cache for the process, for whichever context is
+// current; with none set up every lookup misses and nothing is stored.
+
+// Points the cache at `dir`, which is created if it's missing. -1 if the
+// driver can't hand program binaries back, in which case the cache stays off.
+int
+pc_init (const char* dir);
+
+// Key for a program made from `num` source strings; NULL ones count as empty.
+uint64_t
+pc_key (const char* const* sources, int num);
+
+// The program stored under `key`, linked and ready to use; 0 if there's none,
+// or the driver turned it down.
+GLuint
+pc_load (uint64_t key);
+
+// Asks for `program` to be kept retrievable; has to come before linking it.
+void
+pc_prepare (GLuint program);
+
+// Stores a linked `program` under `key`, if it linked.
+void
+pc_store (uint64_t key, GLuint program);
+
+// Hits and misses since pc_init().
+void
+pc_stats (int* hits, int* misses);
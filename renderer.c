@@ -15,17 +15,189 @@
  *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
+#include "program_cache.h"
 #include "renderer.h"
 
-int
-pr_init (struct polygon_renderer* pr)
+// `fs_source` may be NULL for programs that only feed `feedback` (a varying of
+// the vertex shader) back into a buffer; otherwise `feedback` should be NULL.
+static GLuint
+link_program (const char* vs_source, const char* fs_source, const char* feedback)
 {
-    pr->program = glCreateProgram();
+    const char* sources[] = { vs_source, fs_source, feedback };
+    const uint64_t key = pc_key(sources, 3);
+
+    GLuint program = pc_load(key);
+    if (program)
+        return program;
+
+    program = glCreateProgram();
 
     GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
-    GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
 
+    glShaderSource(vertex_shader, 1, &vs_source, NULL);
+    glCompileShader(vertex_shader);
+    glAttachShader(program, vertex_shader);
+
+    if (fs_source)
+    {
+        GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
+
+        glShaderSource(fragment_shader, 1, &fs_source, NULL);
+        glCompileShader(fragment_shader);
+        glAttachShader(program, fragment_shader);
+        glDeleteShader(fragment_shader);
+    }
+
+    if (feedback)
+        glTransformFeedbackVaryings(program, 1, &feedback, GL_INTERLEAVED_ATTRIBS);
+
+    pc_prepare(program);
+    glLinkProgram(program);
+    glDeleteShader(vertex_shader);
+
+    pc_store(key, program);
+
+    return program;
+}
+
+static GLuint
+build_program (const char* vs_source, const char* fs_source)
+{
+    return link_program(vs_source, fs_source, NULL);
+}
+
+// Draws the spectrum from one level per point, read through `sampler` (a
+// samplerBuffer or isamplerBuffer on texture unit 0): the same 3-tap smoothing
+// and alternating sign as the CPU path, with x following from the point index.
+//
+// Thick lines are drawn as one instanced quad per segment, reaching half a
+// line width (and a pixel for the fringe) past each end. Coverage is the
+// distance to the segment, so every join comes out round; overlapping ends
+// are merged with GL_MIN blending instead of darkening each other.
+static void
+build_levels_program (struct levels_program* lp,
+                      const char* sampler,
+                      GLint count,
+                      GLfloat margin,
+                      bool thick)
+{
+    static const char* levels_vs_format = "#version 330 core\n"
+    "uniform %s levels;\n"
+    "uniform int count;\n"
+    "uniform float margin;\n"
+    "uniform float gain;\n"
+    "\n"
+    "float level(int i) {\n"
+    "    return float(texelFetch(levels, i).r);\n"
+    "}\n"
+    "\n"
+    "vec2 point(int i) {\n"
+    "    float y = 0.0;\n"
+    "    if (i > 0 && i < count - 1) {\n"
+    "        float pv = level(i - 1) * 0.225 + level(i) * 0.56 + level(i + 1) * 0.225;\n"
+    "        y = ((i & 1) == 1 ? gain : -gain) * pv;\n"
+    "    }\n"
+    "    float x = -1.0 + margin + 2.0 * (1.0 - margin) * float(i) / float(count);\n"
+    "    return vec2(x, y);\n"
+    "}\n"
+    "\n"
+    "%s";
+
+    static const char* strip_main = ""
+    "void main() {\n"
+    "    gl_Position = vec4(point(gl_VertexID), 0.0, 1.0);\n"
+    "}\n";
+
+    // line.x is the width, line.yz the viewport size, both in pixels.
+    static const char* quad_main = ""
+    "uniform vec3 line;\n"
+    "flat out vec4 segment;\n"
+    "\n"
+    "void main() {\n"
+    "    vec2 a = (point(gl_InstanceID) * 0.5 + 0.5) * line.yz;\n"
+    "    vec2 b = (point(gl_InstanceID + 1) * 0.5 + 0.5) * line.yz;\n"
+    "    vec2 along = b - a;\n"
+    "    along = dot(along, along) > 1e-8 ? normalize(along) : vec2(1.0, 0.0);\n"
+    "    vec2 across = vec2(-along.y, along.x);\n"
+    "\n"
+    "    float reach = 0.5 * line.x + 1.0;\n"
+    "    vec2 end = (gl_VertexID & 1) == 0 ? a - reach * along : b + reach * along;\n"
+    "    vec2 corner = end + ((gl_VertexID & 2) == 0 ? -reach : reach) * across;\n"
+    "\n"
+    "    segment = vec4(a, b);\n"
+    "    gl_Position = vec4(corner / line.yz * 2.0 - 1.0, 0.0, 1.0);\n"
+    "}\n";
+
+    static const char* strip_fs = "#version 330 core\n"
+    "out vec4 FragColor;\n"
+    "\n"
+    "void main() {\n"
+    "    FragColor = vec4(0.0, 0.0, 0.0, 1.0);\n"
+    "}\n";
+
+    // Written as 1 - coverage, which GL_MIN blending turns into black over
+    // whatever is already there.
+    static const char* quad_fs = "#version 330 core\n"
+    "uniform vec3 line;\n"
+    "flat in vec4 segment;\n"
+    "out vec4 FragColor;\n"
+    "\n"
+    "void main() {\n"
+    "    vec2 p = gl_FragCoord.xy - segment.xy;\n"
+    "    vec2 ab = segment.zw - segment.xy;\n"
+    "    float t = clamp(dot(p, ab) / max(dot(ab, ab), 1e-8), 0.0, 1.0);\n"
+    "    float coverage = clamp(0.5 * line.x + 0.5 - length(p - t * ab), 0.0, 1.0);\n"
+    "    FragColor = vec4(1.0 - coverage);\n"
+    "}\n";
+
+    char levels_vs[2048];
+    snprintf(levels_vs, sizeof levels_vs, levels_vs_format, sampler,
+             thick ? quad_main : strip_main);
+
+    lp->thick = thick;
+    lp->count = count;
+    lp->program = build_program(levels_vs, thick ? quad_fs : strip_fs);
+
+    glUseProgram(lp->program);
+    glUniform1i(glGetUniformLocation(lp->program, "levels"), 0);
+    glUniform1i(glGetUniformLocation(lp->program, "count"), count);
+    glUniform1f(glGetUniformLocation(lp->program, "margin"), margin);
+    lp->gain_location = glGetUniformLocation(lp->program, "gain");
+    lp->line_location = glGetUniformLocation(lp->program, "line");
+}
+
+static void
+set_levels_line (struct levels_program* lp, GLfloat width, GLint viewport_width, GLint viewport_height)
+{
+    glUseProgram(lp->program);
+    glUniform3f(lp->line_location, width, viewport_width, viewport_height);
+}
+
+// Expects the levels bound on texture unit 0, and some vertex array bound.
+static void
+draw_levels (struct levels_program* lp, GLfloat gain)
+{
+    glUseProgram(lp->program);
+    glUniform1f(lp->gain_location, gain);
+
+    if (lp->thick)
+    {
+        glEnable(GL_BLEND);
+        glBlendEquation(GL_MIN);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, lp->count - 1);
+        glBlendEquation(GL_FUNC_ADD);
+        glDisable(GL_BLEND);
+    } else
+        glDrawArrays(GL_LINE_STRIP, 0, lp->count);
+}
+
+int
+pr_init (struct polygon_renderer* pr, struct vertex* points, GLsizei num)
+{
     static const char* polygon_renderer_vs = "#version 330 core\n"
     "in vec2 coord;\n"
     "\n"
@@ -40,20 +212,40 @@ pr_init (struct polygon_renderer* pr)
     "    FragColor = vec4(0.0, 0.0, 0.0, 1.0);\n"
     "}\n";
 
-    glShaderSource(vertex_shader, 1, &polygon_renderer_vs, NULL);
-    glCompileShader(vertex_shader);
-    glShaderSource(fragment_shader, 1, &polygon_renderer_fs, NULL);
-    glCompileShader(fragment_shader);
-    glAttachShader(pr->program, vertex_shader);
-    glAttachShader(pr->program, fragment_shader);
-    glLinkProgram(pr->program);
-    glDeleteShader(fragment_shader);
-    glDeleteShader(vertex_shader);
+    const GLsizeiptr size = num * sizeof(struct vertex);
+
+    pr->program = build_program(polygon_renderer_vs, polygon_renderer_fs);
+    pr->num = num;
+    pr->mapped = NULL;
+    pr->staging = NULL;
+    pr->region = PR_REGIONS - 1;
+    for (int i = 0; i < PR_REGIONS; ++i)
+        pr->fences[i] = NULL;
 
     glGenVertexArrays(1, &pr->vao);
     glGenBuffers(1, &pr->vbo);
     glBindVertexArray(pr->vao);
     glBindBuffer(GL_ARRAY_BUFFER, pr->vbo);
+
+    if (GLAD_GL_ARB_buffer_storage)
+    {
+        // Coherent, so what the CPU writes is seen by the next draw without a flush.
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glBufferStorage(GL_ARRAY_BUFFER, PR_REGIONS * size, NULL, flags);
+        pr->mapped = glMapBufferRange(GL_ARRAY_BUFFER, 0, PR_REGIONS * size, flags);
+    }
+
+    if (pr->mapped)
+    {
+        for (int i = 0; i < PR_REGIONS; ++i)
+            memcpy(&pr->mapped[i * num], points, size);
+    } else
+    {
+        pr->staging = points;
+        glBufferData(GL_ARRAY_BUFFER, size, NULL, GL_STREAM_DRAW);
+    }
+
     glVertexAttribPointer(0,
                           2,
                           GL_FLOAT,
@@ -65,22 +257,860 @@ pr_init (struct polygon_renderer* pr)
     return 0;
 }
 
+struct vertex*
+pr_map (struct polygon_renderer* pr)
+{
+    if (!pr->mapped)
+        return pr->staging;
+
+    pr->region = (pr->region + 1) % PR_REGIONS;
+
+    // Two frames old by now, so this hardly ever has to wait.
+    GLsync fence = pr->fences[pr->region];
+    if (fence)
+    {
+        GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+
+        while (glClientWaitSync(fence, flags, 1000000000) == GL_TIMEOUT_EXPIRED)
+            flags = 0;
+
+        glDeleteSync(fence);
+        pr->fences[pr->region] = NULL;
+    }
+
+    return &pr->mapped[pr->region * pr->num];
+}
+
 void
-pr_draw (struct polygon_renderer* pr, struct vertex* points, GLsizei num)
+pr_draw (struct polygon_renderer* pr)
 {
     glUseProgram(pr->program);
     glBindVertexArray(pr->vao);
-    // Assuming the structure is packed; i.e. 1 struct = 2 floats
-    glBufferData(GL_ARRAY_BUFFER, num * sizeof(struct vertex), points, GL_STREAM_DRAW);
-    glClearColor(1.0, 1.0, 0.0, 1.0);
-    glClear(GL_COLOR_BUFFER_BIT);
-    glDrawArrays(GL_LINE_STRIP, 0, num);
+
+    if (!pr->mapped)
+    {
+        // GL_ARRAY_BUFFER isn't part of the VAO state, and other renderers bind their own.
+        glBindBuffer(GL_ARRAY_BUFFER, pr->vbo);
+        // Orphaned first, so the upload never waits on last frame's draw.
+        glBufferData(GL_ARRAY_BUFFER, pr->num * sizeof(struct vertex), NULL, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, pr->num * sizeof(struct vertex), pr->staging);
+    }
+
+    if (pr->mapped)
+    {
+        glDrawArrays(GL_LINE_STRIP, pr->region * pr->num, pr->num);
+        pr->fences[pr->region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    } else
+        glDrawArrays(GL_LINE_STRIP, 0, pr->num);
 }
 
 void
 pr_deinit (struct polygon_renderer* pr)
 {
+    for (int i = 0; i < PR_REGIONS; ++i)
+        if (pr->fences[i])
+            glDeleteSync(pr->fences[i]);
+
+    if (pr->mapped)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, pr->vbo);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+    }
+
     glDeleteVertexArrays(1, &pr->vao);
     glDeleteBuffers(1, &pr->vbo);
     glDeleteProgram(pr->program);
 }
+
+int
+lr_init (struct level_renderer* lr,
+         int num_points,
+         GLenum format,
+         GLfloat level_scale,
+         GLfloat margin,
+         bool thick)
+{
+    lr->level_scale = level_scale;
+    lr->levels_size = num_points * (format == GL_R32F ? sizeof(GLfloat) : sizeof(GLint));
+    build_levels_program(&lr->draw, format == GL_R32F ? "samplerBuffer" : "isamplerBuffer",
+                         num_points, margin, thick);
+
+    glGenBuffers(1, &lr->levels_buffer);
+    glGenTextures(1, &lr->levels_texture);
+    glGenVertexArrays(1, &lr->vao);
+
+    glBindBuffer(GL_TEXTURE_BUFFER, lr->levels_buffer);
+    glBufferData(GL_TEXTURE_BUFFER, lr->levels_size, NULL, GL_STREAM_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, lr->levels_texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, format, lr->levels_buffer);
+
+    return 0;
+}
+
+void
+lr_upload (struct level_renderer* lr, const void* levels)
+{
+    // Orphaned every frame, so the upload never waits on last frame's draw.
+    glBindBuffer(GL_TEXTURE_BUFFER, lr->levels_buffer);
+    glBufferData(GL_TEXTURE_BUFFER, lr->levels_size, levels, GL_STREAM_DRAW);
+}
+
+void
+lr_draw (struct level_renderer* lr, GLfloat gain)
+{
+    lr_draw_from(lr, lr->levels_texture, gain);
+}
+
+GLuint
+lr_levels (struct level_renderer* lr)
+{
+    return lr->levels_texture;
+}
+
+void
+lr_draw_from (struct level_renderer* lr, GLuint levels_texture, GLfloat gain)
+{
+    // Bound anew every draw, which is also what makes another context's
+    // upload visible here.
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, levels_texture);
+    glBindVertexArray(lr->vao);
+    draw_levels(&lr->draw, lr->level_scale * gain);
+}
+
+void
+lr_set_line (struct level_renderer* lr, GLfloat width, GLint viewport_width, GLint viewport_height)
+{
+    set_levels_line(&lr->draw, width, viewport_width, viewport_height);
+}
+
+void
+lr_deinit (struct level_renderer* lr)
+{
+    glDeleteVertexArrays(1, &lr->vao);
+    glDeleteTextures(1, &lr->levels_texture);
+    glDeleteBuffers(1, &lr->levels_buffer);
+    glDeleteProgram(lr->draw.program);
+}
+
+int
+sr_init (struct strip_renderer* sr, int num_cells, float height)
+{
+    // One quad per cell, expanded from gl_VertexID; only the levels are uploaded.
+    static const char* strip_renderer_vs = "#version 330 core\n"
+    "layout(location = 0) in float level;\n"
+    "uniform int cells;\n"
+    "uniform float height;\n"
+    "out float v_level;\n"
+    "\n"
+    "void main() {\n"
+    "    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);\n"
+    "    float width = 2.0 / float(cells);\n"
+    "    // A thin gap between neighbouring cells.\n"
+    "    float x = -1.0 + width * (float(gl_InstanceID) + 0.05 + 0.9 * corner.x);\n"
+    "    gl_Position = vec4(x, -1.0 + height * corner.y, 0.0, 1.0);\n"
+    "    v_level = level;\n"
+    "}\n";
+
+    static const char* strip_renderer_fs = "#version 330 core\n"
+    "in float v_level;\n"
+    "out vec4 FragColor;\n"
+    "\n"
+    "void main() {\n"
+    "    FragColor = vec4(mix(vec3(1.0, 1.0, 0.0), vec3(0.0), clamp(v_level, 0.0, 1.0)), 1.0);\n"
+    "}\n";
+
+    sr->num_cells = num_cells;
+    sr->program = build_program(strip_renderer_vs, strip_renderer_fs);
+
+    glUseProgram(sr->program);
+    glUniform1i(glGetUniformLocation(sr->program, "cells"), num_cells);
+    glUniform1f(glGetUniformLocation(sr->program, "height"), height);
+
+    glGenVertexArrays(1, &sr->vao);
+    glGenBuffers(1, &sr->vbo);
+    glBindVertexArray(sr->vao);
+    glBindBuffer(GL_ARRAY_BUFFER, sr->vbo);
+    glBufferData(GL_ARRAY_BUFFER, num_cells * sizeof(GLfloat), NULL, GL_STREAM_DRAW);
+    glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, sizeof(GLfloat), (const void*)0);
+    glVertexAttribDivisor(0, 1);
+    glEnableVertexAttribArray(0);
+
+    return 0;
+}
+
+void
+sr_draw (struct strip_renderer* sr, const GLfloat* levels)
+{
+    glUseProgram(sr->program);
+    glBindVertexArray(sr->vao);
+    glBindBuffer(GL_ARRAY_BUFFER, sr->vbo);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, sr->num_cells * sizeof(GLfloat), levels);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, sr->num_cells);
+}
+
+void
+sr_deinit (struct strip_renderer* sr)
+{
+    glDeleteVertexArrays(1, &sr->vao);
+    glDeleteBuffers(1, &sr->vbo);
+    glDeleteProgram(sr->program);
+}
+
+int
+mr_init (struct marker_renderer* mr)
+{
+    // Both ends come from gl_VertexID; there's nothing to upload but the position.
+    static const char* marker_renderer_vs = "#version 330 core\n"
+    "uniform float x;\n"
+    "\n"
+    "void main() {\n"
+    "    gl_Position = vec4(x, gl_VertexID == 0 ? -1.0 : 1.0, 0.0, 1.0);\n"
+    "}\n";
+
+    static const char* marker_renderer_fs = "#version 330 core\n"
+    "out vec4 FragColor;\n"
+    "\n"
+    "void main() {\n"
+    "    FragColor = vec4(0.75, 0.0, 0.0, 1.0);\n"
+    "}\n";
+
+    mr->program = build_program(marker_renderer_vs, marker_renderer_fs);
+    mr->x_location = glGetUniformLocation(mr->program, "x");
+
+    // The core profile wants some VAO bound, even without attributes.
+    glGenVertexArrays(1, &mr->vao);
+
+    return 0;
+}
+
+void
+mr_draw (struct marker_renderer* mr, GLfloat x)
+{
+    glUseProgram(mr->program);
+    glBindVertexArray(mr->vao);
+    glUniform1f(mr->x_location, x);
+    glDrawArrays(GL_LINES, 0, 2);
+}
+
+void
+mr_deinit (struct marker_renderer* mr)
+{
+    glDeleteVertexArrays(1, &mr->vao);
+    glDeleteProgram(mr->program);
+}
+
+int
+wr_init (struct waveform_renderer* wr, GLenum type, GLfloat margin)
+{
+    static const char* waveform_renderer_vs = "#version 330 core\n"
+    "layout(location = 0) in float sample;\n"
+    "uniform int count;\n"
+    "uniform float margin;\n"
+    "uniform float scale;\n"
+    "\n"
+    "void main() {\n"
+    "    float x = -1.0 + margin + 2.0 * (1.0 - margin) * float(gl_VertexID) / float(count - 1);\n"
+    "    gl_Position = vec4(x, scale * sample, 0.0, 1.0);\n"
+    "}\n";
+
+    static const char* waveform_renderer_fs = "#version 330 core\n"
+    "out vec4 FragColor;\n"
+    "\n"
+    "void main() {\n"
+    "    FragColor = vec4(0.0, 0.0, 0.0, 1.0);\n"
+    "}\n";
+
+    wr->type = type;
+    wr->num = 0;
+    wr->program = build_program(waveform_renderer_vs, waveform_renderer_fs);
+    wr->count_location = glGetUniformLocation(wr->program, "count");
+    wr->scale_location = glGetUniformLocation(wr->program, "scale");
+
+    glUseProgram(wr->program);
+    glUniform1f(glGetUniformLocation(wr->program, "margin"), margin);
+
+    glGenVertexArrays(1, &wr->vao);
+    glGenBuffers(1, &wr->vbo);
+    glBindVertexArray(wr->vao);
+    glBindBuffer(GL_ARRAY_BUFFER, wr->vbo);
+    glVertexAttribPointer(0,
+                          1,
+                          type,
+                          type != GL_FLOAT,
+                          0,
+                          (const void*)0);
+    glEnableVertexAttribArray(0);
+
+    return 0;
+}
+
+void
+wr_upload (struct waveform_renderer* wr, const void* samples, GLsizei num)
+{
+    const GLsizeiptr size = num * (wr->type == GL_FLOAT ? sizeof(GLfloat) : sizeof(GLshort));
+
+    glBindBuffer(GL_ARRAY_BUFFER, wr->vbo);
+    glBufferData(GL_ARRAY_BUFFER, size, samples, GL_STREAM_DRAW);
+    wr->num = num;
+}
+
+void
+wr_draw (struct waveform_renderer* wr, GLfloat scale)
+{
+    wr_draw_from(wr, wr, scale);
+}
+
+void
+wr_draw_from (struct waveform_renderer* wr, const struct waveform_renderer* source, GLfloat scale)
+{
+    glUseProgram(wr->program);
+    glUniform1i(wr->count_location, source->num);
+    glUniform1f(wr->scale_location, scale);
+    glBindVertexArray(wr->vao);
+
+    // Pointed at the source's buffer for every draw, for the same reason
+    // lr_draw_from() binds its texture.
+    if (source != wr)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, source->vbo);
+        glVertexAttribPointer(0, 1, wr->type, wr->type != GL_FLOAT, 0, (const void*)0);
+    }
+
+    glDrawArrays(GL_LINE_STRIP, 0, source->num);
+}
+
+void
+wr_deinit (struct waveform_renderer* wr)
+{
+    glDeleteVertexArrays(1, &wr->vao);
+    glDeleteBuffers(1, &wr->vbo);
+    glDeleteProgram(wr->program);
+}
+
+int
+br_init (struct band_renderer* br,
+         const GLint* ranges,
+         int num_points,
+         int fft_size,
+         GLenum bins_format,
+         GLfloat bins_scale,
+         GLfloat margin,
+         GLuint bins_buffer,
+         bool thick)
+{
+    // Band peak and exponential smoothing, one vertex per band; the result is
+    // captured with transform feedback and comes back as `previous` next frame.
+    static const char* reduce_vs_format = "#version 330 core\n"
+    "layout(location = 0) in float previous;\n"
+    "uniform %s bins;\n"
+    "uniform isamplerBuffer ranges;\n"
+    "uniform float scale;\n"
+    "uniform float tau;\n"
+    "out float level;\n"
+    "\n"
+    "void main() {\n"
+    "    ivec2 range = texelFetch(ranges, gl_VertexID).xy;\n"
+    "    float peak = 0.0;\n"
+    "    for (int i = 0; i < range.y; ++i)\n"
+    "        peak = max(peak, length(vec2(texelFetch(bins, range.x + i).xy)));\n"
+    "    level = previous * tau + (1.0 - tau) * scale * peak;\n"
+    "}\n";
+
+    char reduce_vs[1024];
+    snprintf(reduce_vs, sizeof reduce_vs, reduce_vs_format,
+             bins_format == GL_RG32F ? "samplerBuffer" : "isamplerBuffer");
+
+    br->num_points = num_points;
+    br->bins_format = bins_format;
+    br->bins_size = fft_size * (bins_format == GL_RG32F ? 2 * sizeof(GLfloat) : 2 * sizeof(GLshort));
+    br->current = 0;
+
+    br->reduce_program = link_program(reduce_vs, NULL, "level");
+    build_levels_program(&br->draw, "samplerBuffer", num_points, margin, thick);
+
+    glUseProgram(br->reduce_program);
+    glUniform1i(glGetUniformLocation(br->reduce_program, "bins"), 0);
+    glUniform1i(glGetUniformLocation(br->reduce_program, "ranges"), 1);
+    br->scale_location = glGetUniformLocation(br->reduce_program, "scale");
+    glUniform1f(br->scale_location, bins_scale);
+    br->tau_location = glGetUniformLocation(br->reduce_program, "tau");
+
+    br->own_bins = bins_buffer == 0;
+    if (br->own_bins)
+    {
+        glGenBuffers(1, &br->bins_buffer);
+        glBindBuffer(GL_TEXTURE_BUFFER, br->bins_buffer);
+        glBufferData(GL_TEXTURE_BUFFER, br->bins_size, NULL, GL_STREAM_DRAW);
+    } else
+        br->bins_buffer = bins_buffer;
+
+    glGenBuffers(1, &br->ranges_buffer);
+    glGenBuffers(2, br->levels_buffer);
+    glGenTextures(1, &br->bins_texture);
+    glGenTextures(1, &br->ranges_texture);
+    glGenTextures(2, br->levels_texture);
+    glGenVertexArrays(2, br->levels_vao);
+    glGenVertexArrays(1, &br->draw_vao);
+
+    glBindTexture(GL_TEXTURE_BUFFER, br->bins_texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, bins_format, br->bins_buffer);
+
+    // Only rewritten by br_resize().
+    glBindBuffer(GL_TEXTURE_BUFFER, br->ranges_buffer);
+    glBufferData(GL_TEXTURE_BUFFER, num_points * 2 * sizeof(GLint), ranges, GL_STATIC_DRAW);
+    glBindTexture(GL_TEXTURE_BUFFER, br->ranges_texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32I, br->ranges_buffer);
+
+    // Smoothing starts from silence.
+    GLfloat *zeros = calloc(num_points, sizeof(GLfloat));
+    if (!zeros)
+        return -1;
+
+    for (int i = 0; i < 2; ++i)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, br->levels_buffer[i]);
+        glBufferData(GL_ARRAY_BUFFER, num_points * sizeof(GLfloat), zeros, GL_DYNAMIC_COPY);
+
+        glBindVertexArray(br->levels_vao[i]);
+        glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, sizeof(GLfloat), (const void*)0);
+        glEnableVertexAttribArray(0);
+
+        glBindTexture(GL_TEXTURE_BUFFER, br->levels_texture[i]);
+        glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, br->levels_buffer[i]);
+    }
+
+    free(zeros);
+
+    return 0;
+}
+
+void
+br_resize (struct band_renderer* br, const GLint* ranges, int fft_size, GLfloat bins_scale)
+{
+    // The bins are orphaned at every upload anyway; the new size takes from the next.
+    br->bins_size = fft_size * (br->bins_format == GL_RG32F ? 2 * sizeof(GLfloat) : 2 * sizeof(GLshort));
+
+    glBindBuffer(GL_TEXTURE_BUFFER, br->ranges_buffer);
+    glBufferSubData(GL_TEXTURE_BUFFER, 0, br->num_points * 2 * sizeof(GLint), ranges);
+
+    glUseProgram(br->reduce_program);
+    glUniform1f(br->scale_location, bins_scale);
+}
+
+void
+br_update (struct band_renderer* br, const void* bins, GLfloat tau)
+{
+    const int next = 1 - br->current;
+
+    glUseProgram(br->reduce_program);
+    glUniform1f(br->tau_location, tau);
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_BUFFER, br->ranges_texture);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, br->bins_texture);
+
+    // Orphaned every frame, so the upload never waits on last frame's reads.
+    if (br->own_bins)
+    {
+        glBindBuffer(GL_TEXTURE_BUFFER, br->bins_buffer);
+        glBufferData(GL_TEXTURE_BUFFER, br->bins_size, bins, GL_STREAM_DRAW);
+    }
+
+    // Reads the levels of the last frame, writes this one's into the other buffer.
+    glBindVertexArray(br->levels_vao[br->current]);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, br->levels_buffer[next]);
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, br->num_points);
+    glEndTransformFeedback();
+    glDisable(GL_RASTERIZER_DISCARD);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+
+    br->current = next;
+}
+
+void
+br_draw (struct band_renderer* br, GLfloat gain)
+{
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_BUFFER, br->levels_texture[br->current]);
+    glBindVertexArray(br->draw_vao);
+    draw_levels(&br->draw, gain);
+}
+
+GLuint
+br_levels (struct band_renderer* br)
+{
+    return br->levels_texture[br->current];
+}
+
+GLuint
+br_levels_buffer (struct band_renderer* br)
+{
+    return br->levels_buffer[br->current];
+}
+
+void
+br_set_line (struct band_renderer* br, GLfloat width, GLint viewport_width, GLint viewport_height)
+{
+    set_levels_line(&br->draw, width, viewport_width, viewport_height);
+}
+
+void
+br_deinit (struct band_renderer* br)
+{
+    glDeleteVertexArrays(1, &br->draw_vao);
+    glDeleteVertexArrays(2, br->levels_vao);
+    glDeleteTextures(2, br->levels_texture);
+    glDeleteTextures(1, &br->ranges_texture);
+    glDeleteTextures(1, &br->bins_texture);
+    glDeleteBuffers(2, br->levels_buffer);
+    glDeleteBuffers(1, &br->ranges_buffer);
+    if (br->own_bins)
+        glDeleteBuffers(1, &br->bins_buffer);
+    glDeleteProgram(br->draw.program);
+    glDeleteProgram(br->reduce_program);
+}
+
+int
+wf_init (struct waterfall_renderer* wf,
+         int num_points,
+         int num_rows,
+         GLenum format,
+         GLfloat level_scale,
+         GLfloat margin)
+{
+    // One quad over the viewport, from gl_VertexID; its sides are half a point
+    // past the first and the last, so each column of texels is centred on one.
+    static const char* waterfall_vs = "#version 330 core\n"
+    "uniform int count;\n"
+    "uniform float margin;\n"
+    "out vec2 uv;\n"
+    "\n"
+    "void main() {\n"
+    "    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);\n"
+    "    float span = 2.0 * (1.0 - margin);\n"
+    "    float x = -1.0 + margin + span * (corner.x - 0.5 / float(count));\n"
+    "    gl_Position = vec4(x, 2.0 * corner.y - 1.0, 0.0, 1.0);\n"
+    "    uv = vec2(corner.x, 1.0 - corner.y);\n"
+    "}\n";
+
+    // uv.y is the age, from 0 at the top to the whole history at the bottom.
+    // Rows are read back from the newest, wrapping round the texture (GL_REPEAT).
+    static const char* waterfall_fs = "#version 330 core\n"
+    "uniform sampler2D history;\n"
+    "uniform int newest;\n"
+    "uniform int filled;\n"
+    "uniform float gain;\n"
+    "in vec2 uv;\n"
+    "out vec4 FragColor;\n"
+    "\n"
+    "void main() {\n"
+    "    float rows = float(textureSize(history, 0).y);\n"
+    "    float age = uv.y * rows;\n"
+    "    // Rows not written yet leave the background as it is.\n"
+    "    if (age >= float(filled))\n"
+    "        discard;\n"
+    "    // Kept off the seam, where linear filtering would blend the newest row\n"
+    "    // with the oldest, and off the rows past `filled`, never written.\n"
+    "    age = clamp(age, 0.5, min(float(filled), rows) - 0.5);\n"
+    "    float level = gain * texture(history, vec2(uv.x, (float(newest) + 1.0 - age) / rows)).r;\n"
+    "    // -60 to 0 dB.\n"
+    "    float shade = clamp(6.0206 * log2(max(level, 1e-6)) / 60.0 + 1.0, 0.0, 1.0);\n"
+    "    FragColor = vec4(mix(vec3(1.0, 1.0, 0.0), vec3(0.9, 0.3, 0.0), shade), 1.0);\n"
+    "}\n";
+
+    GLint max_size;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_size);
+
+    if (num_rows && (num_points > max_size || num_rows > max_size))
+        return -1;
+
+    wf->format = format;
+    wf->level_scale = level_scale;
+    wf->num_points = num_points;
+    wf->num_rows = num_rows;
+    wf->newest = num_rows - 1;
+    wf->filled = 0;
+    wf->texture = 0;
+
+    wf->staging = NULL;
+    if (format == GL_R32I && num_rows)
+    {
+        wf->staging = malloc(num_points * sizeof(GLfloat));
+        if (!wf->staging)
+            return -1;
+    }
+
+    wf->program = build_program(waterfall_vs, waterfall_fs);
+    wf->newest_location = glGetUniformLocation(wf->program, "newest");
+    wf->filled_location = glGetUniformLocation(wf->program, "filled");
+    wf->gain_location = glGetUniformLocation(wf->program, "gain");
+
+    glUseProgram(wf->program);
+    glUniform1i(glGetUniformLocation(wf->program, "history"), 0);
+    glUniform1i(glGetUniformLocation(wf->program, "count"), num_points);
+    glUniform1f(glGetUniformLocation(wf->program, "margin"), margin);
+
+    // The core profile wants some VAO bound, even without attributes.
+    glGenVertexArrays(1, &wf->vao);
+
+    if (num_rows)
+    {
+        // Never cleared; rows count only once they're written (`filled`).
+        glGenTextures(1, &wf->texture);
+        glBindTexture(GL_TEXTURE_2D, wf->texture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R16F, num_points, num_rows, 0, GL_RED, GL_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    }
+
+    return 0;
+}
+
+// Over the oldest row, which becomes the newest.
+static void
+wf_write_row (struct waterfall_renderer* wf, const void* row)
+{
+    wf->newest = (wf->newest + 1) % wf->num_rows;
+    wf->filled += wf->filled < wf->num_rows;
+
+    glBindTexture(GL_TEXTURE_2D, wf->texture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, wf->newest, wf->num_points, 1, GL_RED, GL_FLOAT, row);
+}
+
+void
+wf_push (struct waterfall_renderer* wf, const void* levels)
+{
+    if (wf->format == GL_R32I)
+    {
+        const GLint* q = levels;
+
+        for (int i = 0; i < wf->num_points; ++i)
+            wf->staging[i] = wf->level_scale * q[i];
+
+        levels = wf->staging;
+    }
+
+    wf_write_row(wf, levels);
+}
+
+void
+wf_push_from (struct waterfall_renderer* wf, GLuint buffer)
+{
+    // Read as an offset into the buffer, and copied on the GPU.
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+    wf_write_row(wf, (const void*)0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+void
+wf_draw (struct waterfall_renderer* wf, GLfloat gain)
+{
+    wf_draw_from(wf, wf, gain);
+}
+
+void
+wf_draw_from (struct waterfall_renderer* wf, const struct waterfall_renderer* source, GLfloat gain)
+{
+    glUseProgram(wf->program);
+    glUniform1i(wf->newest_location, source->newest);
+    glUniform1i(wf->filled_location, source->filled);
+    glUniform1f(wf->gain_location, gain);
+
+    // Bound anew every draw, as in lr_draw_from().
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, source->texture);
+    glBindVertexArray(wf->vao);
+    glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+}
+
+void
+wf_deinit (struct waterfall_renderer* wf)
+{
+    glDeleteVertexArrays(1, &wf->vao);
+    glDeleteTextures(1, &wf->texture);
+    glDeleteProgram(wf->program);
+    free(wf->staging);
+}
+
+static int
+aa_samples (enum aa_mode mode)
+{
+    return mode == AA_MSAA8 ? 8 : mode == AA_MSAA4 ? 4 : 0;
+}
+
+int
+aa_init (struct aa_pass* aa, enum aa_mode mode, GLuint target, GLsizei width, GLsizei height)
+{
+    // One full-screen triangle; the usual FXAA, with 4 diagonal taps to find
+    // the edge direction, and blurring along it unless that overshoots.
+    static const char* fxaa_vs = "#version 330 core\n"
+    "out vec2 uv;\n"
+    "\n"
+    "void main() {\n"
+    "    uv = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);\n"
+    "    gl_Position = vec4(uv * 2.0 - 1.0, 0.0, 1.0);\n"
+    "}\n";
+
+    static const char* fxaa_fs = "#version 330 core\n"
+    "uniform sampler2D frame;\n"
+    "uniform vec2 texel;\n"
+    "in vec2 uv;\n"
+    "out vec4 FragColor;\n"
+    "\n"
+    "const vec3 LUMA = vec3(0.299, 0.587, 0.114);\n"
+    "const float REDUCE_MIN = 1.0 / 128.0;\n"
+    "const float REDUCE_MUL = 1.0 / 8.0;\n"
+    "const float SPAN_MAX = 8.0;\n"
+    "\n"
+    "void main() {\n"
+    "    float nw = dot(texture(frame, uv + vec2(-1.0, -1.0) * texel).rgb, LUMA);\n"
+    "    float ne = dot(texture(frame, uv + vec2( 1.0, -1.0) * texel).rgb, LUMA);\n"
+    "    float sw = dot(texture(frame, uv + vec2(-1.0,  1.0) * texel).rgb, LUMA);\n"
+    "    float se = dot(texture(frame, uv + vec2( 1.0,  1.0) * texel).rgb, LUMA);\n"
+    "    vec3 m = texture(frame, uv).rgb;\n"
+    "    float lm = dot(m, LUMA);\n"
+    "\n"
+    "    float lmin = min(lm, min(min(nw, ne), min(sw, se)));\n"
+    "    float lmax = max(lm, max(max(nw, ne), max(sw, se)));\n"
+    "\n"
+    "    vec2 dir = vec2(-((nw + ne) - (sw + se)), (nw + sw) - (ne + se));\n"
+    "    float reduce = max((nw + ne + sw + se) * 0.25 * REDUCE_MUL, REDUCE_MIN);\n"
+    "    float scale = 1.0 / (min(abs(dir.x), abs(dir.y)) + reduce);\n"
+    "    dir = clamp(dir * scale, -SPAN_MAX, SPAN_MAX) * texel;\n"
+    "\n"
+    "    vec3 a = 0.5 * (texture(frame, uv + dir * (1.0 / 3.0 - 0.5)).rgb\n"
+    "                  + texture(frame, uv + dir * (2.0 / 3.0 - 0.5)).rgb);\n"
+    "    vec3 b = 0.5 * a + 0.25 * (texture(frame, uv - dir * 0.5).rgb\n"
+    "                             + texture(frame, uv + dir * 0.5).rgb);\n"
+    "    float lb = dot(b, LUMA);\n"
+    "\n"
+    "    FragColor = vec4(lb < lmin || lb > lmax ? a : b, 1.0);\n"
+    "}\n";
+
+    aa->mode = mode;
+    aa->target = target;
+    aa->fbo = aa->color = aa->vao = aa->program = 0;
+
+    if (mode == AA_OFF)
+        return 0;
+
+    GLint max_samples = 0;
+    glGetIntegerv(GL_MAX_SAMPLES, &max_samples);
+    if (aa_samples(mode) > max_samples)
+        return -1;
+
+    glGenFramebuffers(1, &aa->fbo);
+
+    if (mode == AA_FXAA)
+    {
+        aa->program = build_program(fxaa_vs, fxaa_fs);
+        glUseProgram(aa->program);
+        glUniform1i(glGetUniformLocation(aa->program, "frame"), 0);
+        aa->texel_location = glGetUniformLocation(aa->program, "texel");
+
+        glGenVertexArrays(1, &aa->vao);
+        glGenTextures(1, &aa->color);
+        glBindTexture(GL_TEXTURE_2D, aa->color);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    } else
+        glGenRenderbuffers(1, &aa->color);
+
+    aa_resize(aa, width, height);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, aa->fbo);
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, aa->target);
+
+    if (status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        aa_deinit(aa);
+        return -1;
+    }
+
+    return 0;
+}
+
+void
+aa_resize (struct aa_pass* aa, GLsizei width, GLsizei height)
+{
+    aa->width = width;
+    aa->height = height;
+
+    if (aa->mode == AA_OFF)
+        return;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, aa->fbo);
+
+    if (aa->mode == AA_FXAA)
+    {
+        glBindTexture(GL_TEXTURE_2D, aa->color);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, aa->color, 0);
+
+        glUseProgram(aa->program);
+        glUniform2f(aa->texel_location, 1.0 / width, 1.0 / height);
+    } else
+    {
+        glBindRenderbuffer(GL_RENDERBUFFER, aa->color);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, aa_samples(aa->mode), GL_RGBA8, width, height);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, aa->color);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, aa->target);
+}
+
+void
+aa_begin (struct aa_pass* aa)
+{
+    glBindFramebuffer(GL_FRAMEBUFFER, aa->mode == AA_OFF ? aa->target : aa->fbo);
+
+    glClearColor(1.0, 1.0, 0.0, 1.0);
+    glClear(GL_COLOR_BUFFER_BIT);
+}
+
+void
+aa_end (struct aa_pass* aa)
+{
+    if (aa->mode == AA_OFF)
+        return;
+
+    if (aa->mode == AA_FXAA)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, aa->target);
+        glUseProgram(aa->program);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, aa->color);
+        glBindVertexArray(aa->vao);
+        glDrawArrays(GL_TRIANGLES, 0, 3);
+    } else
+    {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, aa->fbo);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, aa->target);
+        glBlitFramebuffer(0, 0, aa->width, aa->height, 0, 0, aa->width, aa->height,
+                          GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, aa->target);
+    }
+}
+
+void
+aa_deinit (struct aa_pass* aa)
+{
+    if (aa->mode == AA_FXAA)
+    {
+        glDeleteTextures(1, &aa->color);
+        glDeleteVertexArrays(1, &aa->vao);
+        glDeleteProgram(aa->program);
+    } else
+        glDeleteRenderbuffers(1, &aa->color);
+
+    glDeleteFramebuffers(1, &aa->fbo);
+}
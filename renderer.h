@@ -24,18 +24,319 @@ struct vertex
     GLfloat x, y;
 };
 
+// Copies of the vertices in flight; the CPU writes one while the GPU reads the others.
+#define PR_REGIONS 3
+
 struct polygon_renderer
 {
     GLuint vbo;
     GLuint vao;
     GLuint program;
+    GLsizei num;
+
+    // With ARB_buffer_storage, the vbo holds PR_REGIONS copies of the vertices,
+    // mapped for good; each is fenced from its draw until it comes round again.
+    struct vertex* mapped;
+    GLsync fences[PR_REGIONS];
+    int region;
+
+    // Without it, vertices are written here and uploaded into an orphaned vbo.
+    struct vertex* staging;
 };
 
+// Every copy of the vertices starts out as `points`; only what changes has to
+// be written afterwards. Without ARB_buffer_storage `points` itself is the
+// copy, so it has to outlive the renderer.
 int
-pr_init (struct polygon_renderer* pr);
+pr_init (struct polygon_renderer* pr, struct vertex* points, GLsizei num);
+
+// The vertices to write this frame's into; waits if the GPU is still reading them.
+struct vertex*
+pr_map (struct polygon_renderer* pr);
 
+// Draws the vertices last handed out by pr_map().
 void
-pr_draw (struct polygon_renderer* pr, struct vertex* points, GLsizei num);
+pr_draw (struct polygon_renderer* pr);
 
 void
 pr_deinit(struct polygon_renderer* pr);
+
+// Draws the spectrum from a buffer texture of levels, as a line strip, or as
+// thick lines with analytic anti-aliasing (no MSAA needed); shared by the
+// level and band renderers.
+struct levels_program
+{
+    GLuint program;
+    GLint gain_location;
+    GLint line_location;
+    int count;
+    bool thick;
+};
+
+// The Mel spectrum drawn from the band levels alone; the vertex shader places,
+// smooths and signs the points, so only one level per point is uploaded.
+struct level_renderer
+{
+    GLuint levels_buffer, levels_texture;
+    GLuint vao;
+    struct levels_program draw;
+    GLfloat level_scale;
+    GLsizeiptr levels_size;
+};
+
+// Levels are GL_R32F, or GL_R32I (e.g. Q15); `level_scale` takes them to 1.0.
+int
+lr_init (struct level_renderer* lr,
+         int num_points,
+         GLenum format,
+         GLfloat level_scale,
+         GLfloat margin,
+         bool thick);
+
+// Uploads the levels lr_draw() draws next; in the format given to lr_init().
+void
+lr_upload (struct level_renderer* lr, const void* levels);
+
+void
+lr_draw (struct level_renderer* lr, GLfloat gain);
+
+// The buffer texture the levels are uploaded into.
+GLuint
+lr_levels (struct level_renderer* lr);
+
+// Draws the levels of another renderer, on a context shared with this one:
+// lr_levels() or br_levels(), which have to be in the format this one takes.
+void
+lr_draw_from (struct level_renderer* lr, GLuint levels_texture, GLfloat gain);
+
+// Width of thick lines, and the viewport they're drawn into, in pixels.
+void
+lr_set_line (struct level_renderer* lr, GLfloat width, GLint viewport_width, GLint viewport_height);
+
+void
+lr_deinit (struct level_renderer* lr);
+
+// A row of cells along the bottom of the viewport, shaded by level (0-1).
+struct strip_renderer
+{
+    GLuint vbo;
+    GLuint vao;
+    GLuint program;
+    int num_cells;
+};
+
+int
+sr_init (struct strip_renderer* sr, int num_cells, float height);
+
+void
+sr_draw (struct strip_renderer* sr, const GLfloat* levels);
+
+void
+sr_deinit (struct strip_renderer* sr);
+
+// A vertical line across the viewport, e.g. to mark a frequency on the spectrum.
+struct marker_renderer
+{
+    GLuint vao;
+    GLuint program;
+    GLint x_location;
+};
+
+int
+mr_init (struct marker_renderer* mr);
+
+void
+mr_draw (struct marker_renderer* mr, GLfloat x);
+
+void
+mr_deinit (struct marker_renderer* mr);
+
+// A trace of raw samples; x comes from gl_VertexID, so only the samples are uploaded.
+struct waveform_renderer
+{
+    GLuint vbo;
+    GLuint vao;
+    GLuint program;
+    GLint count_location;
+    GLint scale_location;
+    // GL_FLOAT, or GL_SHORT for (normalised) S16 samples.
+    GLenum type;
+    // Samples in the last upload.
+    GLsizei num;
+};
+
+int
+wr_init (struct waveform_renderer* wr, GLenum type, GLfloat margin);
+
+// Samples are uploaded as soon as they're captured, and drawn with the rest of
+// the frame.
+void
+wr_upload (struct waveform_renderer* wr, const void* samples, GLsizei num);
+
+void
+wr_draw (struct waveform_renderer* wr, GLfloat scale);
+
+// Draws the samples last uploaded into `source`, on a context shared with
+// this one; both have to take the same type.
+void
+wr_draw_from (struct waveform_renderer* wr, const struct waveform_renderer* source, GLfloat scale);
+
+void
+wr_deinit (struct waveform_renderer* wr);
+
+// The Mel spectrum with band peaks and both kinds of smoothing done on the GPU;
+// only the FFT bins are uploaded. Temporal state is ping-ponged between
+// levels_buffer[0] and [1] with transform feedback.
+struct band_renderer
+{
+    GLuint bins_buffer, bins_texture;
+    GLuint ranges_buffer, ranges_texture;
+    GLuint levels_buffer[2], levels_texture[2], levels_vao[2];
+    GLuint draw_vao;
+    GLuint reduce_program;
+    struct levels_program draw;
+    GLint tau_location, scale_location;
+    GLenum bins_format;
+    GLsizeiptr bins_size;
+    // Whether bins_buffer is ours to upload into (and delete).
+    int own_bins;
+    int num_points;
+    // Index of the levels last written.
+    int current;
+};
+
+// `ranges` holds a (first bin, bin count) pair per point. Bins are complex, in
+// `bins_format`: GL_RG32F, or GL_RG16I; `bins_scale` takes their magnitude to
+// the level the CPU path would show. If `bins_buffer` isn't 0, bins are read
+// from there (e.g. as the GPU FFT leaves them) instead of being uploaded.
+int
+br_init (struct band_renderer* br,
+         const GLint* ranges,
+         int num_points,
+         int fft_size,
+         GLenum bins_format,
+         GLfloat bins_scale,
+         GLfloat margin,
+         GLuint bins_buffer,
+         bool thick);
+
+// Switches to the bands of another transform size; the point count stays.
+void
+br_resize (struct band_renderer* br, const GLint* ranges, int fft_size, GLfloat bins_scale);
+
+// Folds and smooths this frame's bands; `bins` is ignored if the renderer was
+// given a bins_buffer.
+void
+br_update (struct band_renderer* br, const void* bins, GLfloat tau);
+
+// Draws the bands last folded.
+void
+br_draw (struct band_renderer* br, GLfloat gain);
+
+// The buffer texture holding the bands last folded, as GL_R32F levels; it
+// changes with every br_update().
+GLuint
+br_levels (struct band_renderer* br);
+
+// The buffer behind br_levels(), e.g. to copy the levels out of on the GPU.
+GLuint
+br_levels_buffer (struct band_renderer* br);
+
+// As lr_set_line().
+void
+br_set_line (struct band_renderer* br, GLfloat width, GLint viewport_width, GLint viewport_height);
+
+void
+br_deinit (struct band_renderer* br);
+
+// A scrolling history of the spectrum, drawn under it: newest at the top,
+// one row per push. The history is a GL_R16F texture used as a ring; a push
+// writes the oldest row over with glTexSubImage2D, and the shader offsets
+// its reads by the row last written, so nothing already in there is moved.
+struct waterfall_renderer
+{
+    GLuint texture;
+    GLuint vao;
+    GLuint program;
+    GLint newest_location, filled_location, gain_location;
+    GLenum format;
+    GLfloat level_scale;
+    int num_points, num_rows;
+    // Row last written, and how many have been so far (up to num_rows).
+    int newest, filled;
+
+    // GL_R32I levels are converted here first; half floats can't take them
+    // as they are.
+    GLfloat* staging;
+};
+
+// Levels are as lr_init() takes them. With `num_rows` 0 there is no history
+// of its own, only what wf_draw_from() is given. <0 if the history is larger
+// than a texture can be.
+int
+wf_init (struct waterfall_renderer* wf,
+         int num_points,
+         int num_rows,
+         GLenum format,
+         GLfloat level_scale,
+         GLfloat margin);
+
+// Writes a row of levels, in the format given to wf_init().
+void
+wf_push (struct waterfall_renderer* wf, const void* levels);
+
+// Writes a row from GL_R32F levels already in `buffer`, e.g. br_levels_buffer(),
+// without going through the CPU.
+void
+wf_push_from (struct waterfall_renderer* wf, GLuint buffer);
+
+// `gain` as for lr_draw(); the levels are shaded on a dB scale.
+void
+wf_draw (struct waterfall_renderer* wf, GLfloat gain);
+
+// Draws the history of another renderer, on a context shared with this one.
+void
+wf_draw_from (struct waterfall_renderer* wf, const struct waterfall_renderer* source, GLfloat gain);
+
+void
+wf_deinit (struct waterfall_renderer* wf);
+
+enum aa_mode
+{
+    AA_OFF,
+    AA_FXAA,
+    AA_MSAA4,
+    AA_MSAA8,
+};
+
+// Anti-aliasing for the whole frame, drawn into an FBO between aa_begin() and
+// aa_end(): MSAA is resolved with a blit, FXAA is a pass over a single-sample
+// texture. AA_OFF draws straight to the target.
+struct aa_pass
+{
+    enum aa_mode mode;
+    // Where the frame ends up; 0 for the window.
+    GLuint target;
+    GLuint fbo, color;
+    GLuint vao;
+    GLuint program;
+    GLint texel_location;
+    GLsizei width, height;
+};
+
+// <0 if the mode isn't supported, e.g. with too few samples.
+int
+aa_init (struct aa_pass* aa, enum aa_mode mode, GLuint target, GLsizei width, GLsizei height);
+
+void
+aa_resize (struct aa_pass* aa, GLsizei width, GLsizei height);
+
+// Binds the frame's framebuffer, and clears it for the renderers.
+void
+aa_begin (struct aa_pass* aa);
+
+void
+aa_end (struct aa_pass* aa);
+
+void
+aa_deinit (struct aa_pass* aa);
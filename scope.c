@@ -0,0 +1,128 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdint.h>
+#include <string.h>
+
+#include "scope.h"
+
+// The signal has to dip this far (relative to its peak) below zero before a
+// crossing counts, so that noise riding on the crossing can't retrigger.
+static const float SCOPE_HYSTERESIS = 0.1;
+
+// 16 bytes of samples (SSE2/NEON wide); unaligned, since the scan slides one sample at a time.
+typedef kiss_fft_scalar scope_vec __attribute__((vector_size(16), aligned(sizeof(kiss_fft_scalar))));
+typedef __typeof__((scope_vec){0} < (scope_vec){0}) scope_mask;
+
+#define SCOPE_LANES ((int)(sizeof(scope_vec) / sizeof(kiss_fft_scalar)))
+
+static inline int
+any_lane (scope_mask m)
+{
+    uint64_t w[sizeof m / sizeof(uint64_t)];
+    memcpy(w, &m, sizeof m);
+
+    uint64_t any = 0;
+    for (size_t i = 0; i < sizeof w / sizeof *w; ++i)
+        any |= w[i];
+
+    return any != 0;
+}
+
+// Lane-wise m ? a : b; GCC's vector extensions only have ?: in C++.
+static inline scope_vec
+lane_select (scope_mask m, scope_vec a, scope_vec b)
+{
+    return (scope_vec)((m & (scope_mask)a) | (~m & (scope_mask)b));
+}
+
+static float
+peak_of (const kiss_fft_scalar *samples, int len)
+{
+    scope_vec hi = {0}, lo = {0};
+    int i = 0;
+
+    for (; i + SCOPE_LANES <= len; i += SCOPE_LANES)
+    {
+        const scope_vec v = *(const scope_vec*)&samples[i];
+
+        hi = lane_select(v > hi, v, hi);
+        lo = lane_select(v < lo, v, lo);
+    }
+
+    // Wider than a sample, so that -INT16_MIN fits.
+    float peak = 0;
+
+    for (int l = 0; l < SCOPE_LANES; ++l)
+    {
+        peak = hi[l] > peak ? hi[l] : peak;
+        peak = -lo[l] > peak ? -lo[l] : peak;
+    }
+
+    for (; i < len; ++i)
+    {
+        peak = samples[i] > peak ? samples[i] : peak;
+        peak = -samples[i] > peak ? -samples[i] : peak;
+    }
+
+    return peak;
+}
+
+// Whether the negative half-cycle ending right before `i` reached -threshold.
+// Each candidate walks back over its own half-cycle only, so all of them
+// together still cost one pass over the window.
+static inline int
+armed (const kiss_fft_scalar *samples, int i, float threshold)
+{
+    for (int j = i - 1; j >= 0 && samples[j] < 0; --j)
+        if (samples[j] <= -threshold)
+            return 1;
+
+    return 0;
+}
+
+int
+scope_trigger (const kiss_fft_scalar *samples, int len, int span)
+{
+    const int last = len - span;
+    const float threshold = peak_of(samples, len) * SCOPE_HYSTERESIS;
+
+    if (threshold <= 0)
+        return last;
+
+    // Newest first, a block of crossings x[i-1] < 0 <= x[i] at a time.
+    int i = last;
+
+    for (; i - SCOPE_LANES + 1 >= 1; i -= SCOPE_LANES)
+    {
+        const int s = i - SCOPE_LANES + 1;
+        const scope_vec cur = *(const scope_vec*)&samples[s];
+        const scope_vec prev = *(const scope_vec*)&samples[s - 1];
+
+        if (!any_lane((prev < 0) & (cur >= 0)))
+            continue;
+
+        for (int j = i; j >= s; --j)
+            if (samples[j - 1] < 0 && samples[j] >= 0 && armed(samples, j, threshold))
+                return j;
+    }
+
+    for (; i >= 1; --i)
+        if (samples[i - 1] < 0 && samples[i] >= 0 && armed(samples, i, threshold))
+            return i;
+
+    return last;
+}
@@ -0,0 +1,25 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <kiss_fftr.h>
+
+// Samples shown per trace; the rest of the window is where the trigger is looked for.
+#define SCOPE_SPAN(window_size) ((window_size) / 2)
+
+// Start of the latest rising zero crossing in `samples` (of length `len`) that still
+// has `span` samples after it; `len - span` if there's none, i.e. free-running.
+int
+scope_trigger (const kiss_fft_scalar *samples, int len, int span);
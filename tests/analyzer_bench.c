@@ -0,0 +1,120 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Times sa_process() on the host at the window sizes with a specialised taper,
+// and a couple without, in whichever variant it's built for; then what
+// chroma_process() adds on top, over the same bins.
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "analyzer.h"
+#include "arena.h"
+#include "chroma.h"
+
+static const struct { int window_size, num_points; } SIZES[] = {
+    { 1024, 128 },
+    { 2048, 360 },
+    { 4096, 360 },
+    { 8192, 1024 },
+    // Generic taper.
+    { 1536, 300 },
+    { 16384, 360 },
+};
+
+static double
+now (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int
+main (void)
+{
+    for (size_t z = 0; z < sizeof SIZES / sizeof *SIZES; ++z)
+    {
+        const int window_size = SIZES[z].window_size;
+        const int num_points = SIZES[z].num_points;
+
+        struct arena arena;
+        struct spectrum_analyzer sa;
+        struct chroma_analyzer ca;
+
+        const size_t footprint = sa_footprint(window_size, num_points) + chroma_footprint(window_size, 48000);
+
+        if (arena_init(&arena, footprint, false) != 0 ||
+            sa_init(&sa, &arena, window_size, num_points, 48000) != 0 ||
+            chroma_init(&ca, &arena, window_size, 48000) != 0)
+        {
+            fprintf(stderr, "Analyzer initialisation failed at N=%d :(\n", window_size);
+            return EXIT_FAILURE;
+        }
+
+        kiss_fft_scalar *noise = malloc(window_size * sizeof(kiss_fft_scalar));
+        for (int n = 0; n < window_size; ++n)
+#ifdef VSP_FIXED_POINT
+            noise[n] = rand() % 16384 - 8192;
+#else
+            noise[n] = (float)rand() / RAND_MAX - 0.5f;
+#endif
+
+        double frame = 0.0, chroma = 0.0;
+
+        // As long as it takes for a quarter of a second's worth, after a warm-up.
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            int runs = 0;
+            double start = 0.0, elapsed = 0.0;
+
+            for (int i = -16; elapsed < 0.25; ++i)
+            {
+                if (i == 0)
+                    start = now();
+
+                if (pass == 0)
+                {
+                    for (int n = 0; n < window_size; ++n)
+                        sa.sample_win[n] = noise[n];
+                    sa_process(&sa, 0.5);
+                } else
+                    chroma_process(&ca, sa.freq_bins, 0.5);
+
+                if (i >= 0)
+                {
+                    runs = i + 1;
+                    elapsed = now() - start;
+                }
+            }
+
+            if (pass == 0)
+                frame = elapsed / runs;
+            else
+                chroma = elapsed / runs;
+        }
+
+        printf("N=%-5d points=%-5d %8.2f us per frame; chroma %7.2f us more (%.1f%%)\n",
+               window_size, num_points, frame * 1e6, chroma * 1e6, 100.0 * chroma / frame);
+
+        free(noise);
+        arena_deinit(&arena);
+    }
+
+    return EXIT_SUCCESS;
+}
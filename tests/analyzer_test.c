@@ -0,0 +1,202 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Holds sa_process() to a direct DFT in double precision, over fixed signals
+// and a few sizes (specialised kernels and the generic ones alike). Built in
+// either variant; the Q15 one is only allowed a looser bound, which is what
+// keeps it within reach of the float path.
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "analyzer.h"
+#include "arena.h"
+
+#ifdef VSP_FIXED_POINT
+// About -54 dB of full scale; the 16-bit transform rounds at every stage.
+static const double MAX_ERROR = 2e-3;
+#else
+static const double MAX_ERROR = 1e-5;
+#endif
+
+static const int SAMPLE_RATE = 48000;
+
+static const struct { int window_size, num_points; } SIZES[] = {
+    { 1024, 360 },
+    { 4096, 128 },
+    { 2048, 100 },
+    { 1536, 1024 },
+};
+
+static const char *const SIGNALS[] = {
+    "silence", "1 kHz sine", "three tones", "white noise", "440 Hz at -1 dBFS",
+};
+#define NUM_SIGNALS ((int)(sizeof SIGNALS / sizeof *SIGNALS))
+
+static double
+signal_at (int signal, int n)
+{
+    const double t = (double)n / SAMPLE_RATE;
+
+    switch (signal)
+    {
+        case 1:
+            return 0.5 * sin(2.0 * M_PI * 1000.0 * t);
+        case 2:
+            return 0.3 * sin(2.0 * M_PI * 110.0 * t)
+                 + 0.2 * sin(2.0 * M_PI * 2500.0 * t + 1.0)
+                 + 0.1 * sin(2.0 * M_PI * 12000.0 * t + 2.0);
+        case 3:
+        {
+            // Same sequence every run.
+            uint32_t x = 2463534242u + n * 2654435761u;
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            return 0.25 * ((double)x / UINT32_MAX * 2.0 - 1.0);
+        }
+        case 4:
+            return 0.89 * sin(2.0 * M_PI * 440.0 * t);
+        default:
+            return 0.0;
+    }
+}
+
+// Fills the analyzer's window with `signal`, and `x` with the samples exactly
+// as the analyzer sees them.
+static void
+fill_window (struct spectrum_analyzer *sa, int signal, double *x)
+{
+    for (int n = 0; n < sa->window_size; ++n)
+    {
+#ifdef VSP_FIXED_POINT
+        sa->sample_win[n] = lrint(fmin(signal_at(signal, n) * 32768.0, INT16_MAX));
+        x[n] = sa->sample_win[n] / 32768.0;
+#else
+        sa->sample_win[n] = signal_at(signal, n);
+        x[n] = sa->sample_win[n];
+#endif
+    }
+}
+
+// The peak of 2·|X|/N over each point's bins, as sa_reduce() takes it.
+static void
+reference_levels (const struct spectrum_analyzer *sa, const double *x, double *levels)
+{
+    const int N = sa->window_size;
+    double *re = malloc(sa->fft_size * sizeof(double));
+    double *im = malloc(sa->fft_size * sizeof(double));
+    double *c = malloc(N * sizeof(double));
+    double *s = malloc(N * sizeof(double));
+
+    for (int n = 0; n < N; ++n)
+    {
+        c[n] = cos(2.0 * M_PI * n / N);
+        s[n] = sin(2.0 * M_PI * n / N);
+    }
+
+    for (int k = 0; k < sa->fft_size; ++k)
+    {
+        double sr = 0.0, si = 0.0;
+
+        for (int n = 0; n < N; ++n)
+        {
+            const double w = 0.5 * (1.0 - c[n]) * x[n];
+            const int i = (int)((long)k * n % N);
+
+            sr += w * c[i];
+            si -= w * s[i];
+        }
+
+        re[k] = sr;
+        im[k] = si;
+    }
+
+    for (int i = 0; i < sa->num_points; ++i)
+    {
+        double peak = 0.0;
+
+        for (int k = sa->ranges[i].begin; k < sa->ranges[i].begin + sa->ranges[i].count; ++k)
+            peak = fmax(peak, 2.0 / N * hypot(re[k], im[k]));
+
+        levels[i] = peak;
+    }
+
+    free(re);
+    free(im);
+    free(c);
+    free(s);
+}
+
+int
+main (void)
+{
+    int failed = 0;
+
+    for (size_t z = 0; z < sizeof SIZES / sizeof *SIZES; ++z)
+    {
+        const int window_size = SIZES[z].window_size;
+        const int num_points = SIZES[z].num_points;
+
+        struct arena arena;
+        struct spectrum_analyzer sa;
+
+        if (arena_init(&arena, sa_footprint(window_size, num_points), false) != 0 ||
+            sa_init(&sa, &arena, window_size, num_points, SAMPLE_RATE) != 0)
+        {
+            fprintf(stderr, "Analyzer initialisation failed at N=%d :(\n", window_size);
+            return EXIT_FAILURE;
+        }
+
+        double *x = malloc(window_size * sizeof(double));
+        double *expected = malloc(num_points * sizeof(double));
+        double *previous = calloc(num_points, sizeof(double));
+
+        for (int signal = 0; signal < NUM_SIGNALS; ++signal)
+        {
+            // Every other frame smooths into the last one, so the integer
+            // smoothing is held to the same bound.
+            const float tau = signal % 2 ? 0.5 : 0.0;
+            double error = 0.0;
+
+            fill_window(&sa, signal, x);
+            reference_levels(&sa, x, expected);
+            sa_process(&sa, tau);
+
+            for (int i = 0; i < num_points; ++i)
+            {
+                expected[i] = previous[i] * tau + (1.0 - tau) * expected[i];
+                error = fmax(error, fabs(SA_LEVEL_TO_FLOAT(sa.sm_freqs[i]) - expected[i]));
+                previous[i] = expected[i];
+            }
+
+            printf("N=%-5d points=%-5d %-18s max error %.2e\n",
+                   window_size, num_points, SIGNALS[signal], error);
+
+            if (!(error <= MAX_ERROR))
+            {
+                fprintf(stderr, "Off by more than %.0e :(\n", MAX_ERROR);
+                failed = 1;
+            }
+        }
+
+        free(previous);
+        free(expected);
+        free(x);
+        arena_deinit(&arena);
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
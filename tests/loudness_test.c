@@ -0,0 +1,116 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Holds the loudness meter to known readings: BS.1770's -23 LUFS for a 1 kHz
+// sine at -20 dBFS, and true-peak at or above the sample peak, whether the
+// peak falls on a sample (an impulse, a 12 kHz sine in phase with the clock)
+// or between two of them.
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "loudness.h"
+
+static const int SAMPLE_RATE = 48000;
+
+// In dB (or LU) either way.
+static const double MAX_ERROR = 0.1;
+
+static const struct
+{
+    const char *name;
+    // A frequency of 0 is an impulse, half way through.
+    double frequency, amplitude, phase;
+    // LUFS for the loudness, dBTP for the peak; NAN if not checked.
+    double loudness, true_peak;
+} SIGNALS[] = {
+    { "impulse",                0.0,     1.0, 0.0,              NAN,   0.0 },
+    { "1 kHz at -20 dBFS",      1000.0,  0.1, 0.0,              -23.0, -20.0 },
+    { "12 kHz on the samples",  12000.0, 1.0, M_PI / 2.0,       NAN,   0.0 },
+    // Peaks a quarter of a sample after the nearest one, which is at -6.71 dBFS.
+    { "12 kHz between samples", 12000.0, 0.5, 3.0 * M_PI / 8.0, NAN,   -6.02 },
+};
+
+static float
+signal_at (int signal, int n)
+{
+    if (SIGNALS[signal].frequency == 0.0)
+        return n == SAMPLE_RATE / 2 ? SIGNALS[signal].amplitude : 0.0;
+
+    return SIGNALS[signal].amplitude
+         * sin(2.0 * M_PI * SIGNALS[signal].frequency * n / SAMPLE_RATE + SIGNALS[signal].phase);
+}
+
+static int
+check (const char *what, double value, double expected)
+{
+    if (isnan(expected))
+        return 0;
+
+    printf("  %-10s %8.3f (expected %.2f)\n", what, value, expected);
+
+    if (!(fabs(value - expected) <= MAX_ERROR))
+    {
+        fprintf(stderr, "Off by more than %.1f :(\n", MAX_ERROR);
+        return 1;
+    }
+
+    return 0;
+}
+
+int
+main (void)
+{
+    int failed = 0;
+    float *samples = malloc(SAMPLE_RATE * sizeof(float));
+
+    for (size_t s = 0; s < sizeof SIGNALS / sizeof *SIGNALS; ++s)
+    {
+        struct loudness_meter *m = malloc(sizeof *m);
+        float sample_peak = 0.0;
+
+        loudness_init(m, SAMPLE_RATE);
+
+        // A second; long enough for the momentary and integrated readings.
+        for (int n = 0; n < SAMPLE_RATE; ++n)
+        {
+            samples[n] = signal_at(s, n);
+            sample_peak = fmaxf(sample_peak, fabsf(samples[n]));
+        }
+        loudness_process(m, samples, SAMPLE_RATE);
+
+        const double true_peak = atomic_load(&m->true_peak);
+
+        printf("%s:\n", SIGNALS[s].name);
+        failed |= check("momentary", atomic_load(&m->momentary), SIGNALS[s].loudness);
+        failed |= check("integrated", atomic_load(&m->integrated), SIGNALS[s].loudness);
+        failed |= check("true-peak", true_peak, SIGNALS[s].true_peak);
+
+        if (true_peak < 20.0 * log10(sample_peak) - 0.01)
+        {
+            fprintf(stderr, "True-peak %.3f dBTP is below the sample peak, %.3f dBFS :(\n",
+                    true_peak, 20.0 * log10(sample_peak));
+            failed = 1;
+        }
+
+        free(m);
+    }
+
+    free(samples);
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
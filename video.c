@@ -0,0 +1,331 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+#include "video.h"
+
+static inline unsigned char
+bt601_y (int r, int g, int b)
+{
+    return ((66 * r + 129 * g + 25 * b + 128) >> 8) + 16;
+}
+
+static inline unsigned char
+bt601_u (int r, int g, int b)
+{
+    return ((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128;
+}
+
+static inline unsigned char
+bt601_v (int r, int g, int b)
+{
+    return ((112 * r - 94 * g - 18 * b + 128) >> 8) + 128;
+}
+
+// Converts a bottom-up RGBA frame into a top-down 4:2:0 one; the chroma of
+// each 2x2 block is taken from its mean colour.
+static void
+rgba_to_yuv420 (const unsigned char *rgba, int width, int height, unsigned char *yuv)
+{
+    unsigned char *y_plane = yuv;
+    unsigned char *u_plane = y_plane + width * height;
+    unsigned char *v_plane = u_plane + width * height / 4;
+
+    for (int row = 0; row < height; row += 2)
+    {
+        // Rows `row` and `row + 1` of the output, counted from the top.
+        const unsigned char *top = rgba + (size_t)(height - 1 - row) * width * 4;
+        const unsigned char *bottom = top - (size_t)width * 4;
+
+        for (int col = 0; col < width; col += 2)
+        {
+            const unsigned char *p[4] = {
+                top + col * 4, top + col * 4 + 4, bottom + col * 4, bottom + col * 4 + 4
+            };
+
+            int r = 0, g = 0, b = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                r += p[i][0];
+                g += p[i][1];
+                b += p[i][2];
+            }
+
+            y_plane[row * width + col]           = bt601_y(p[0][0], p[0][1], p[0][2]);
+            y_plane[row * width + col + 1]       = bt601_y(p[1][0], p[1][1], p[1][2]);
+            y_plane[(row + 1) * width + col]     = bt601_y(p[2][0], p[2][1], p[2][2]);
+            y_plane[(row + 1) * width + col + 1] = bt601_y(p[3][0], p[3][1], p[3][2]);
+
+            const int chroma = row / 2 * (width / 2) + col / 2;
+            u_plane[chroma] = bt601_u((r + 2) / 4, (g + 2) / 4, (b + 2) / 4);
+            v_plane[chroma] = bt601_v((r + 2) / 4, (g + 2) / 4, (b + 2) / 4);
+        }
+    }
+}
+
+static int
+ve_write_frame (struct video_exporter *ve, const unsigned char *rgba, unsigned char *yuv)
+{
+    const size_t stride = (size_t)ve->width * 4;
+
+    if (ve->format == VE_Y4M)
+    {
+        const size_t size = (size_t)ve->width * ve->height * 3 / 2;
+
+        rgba_to_yuv420(rgba, ve->width, ve->height, yuv);
+
+        if (fputs("FRAME\n", ve->out) < 0 || fwrite(yuv, 1, size, ve->out) != size)
+            return -1;
+    } else
+    {
+        for (int row = ve->height - 1; row >= 0; --row)
+            if (fwrite(rgba + row * stride, 1, stride, ve->out) != stride)
+                return -1;
+    }
+
+    return 0;
+}
+
+static void *
+ve_writer_run (void *_ve)
+{
+    struct video_exporter *ve = _ve;
+
+    unsigned char *yuv = NULL;
+    if (ve->format == VE_Y4M)
+        yuv = malloc((size_t)ve->width * ve->height * 3 / 2);
+
+    pthread_mutex_lock(&ve->lock);
+
+    for (;;)
+    {
+        while (!ve->queued && !ve->quit)
+            pthread_cond_wait(&ve->wake, &ve->lock);
+
+        if (!ve->queued)
+            break;
+
+        // The slot is ours until `head` moves past it.
+        const unsigned char *frame = ve->slots[ve->head];
+        pthread_mutex_unlock(&ve->lock);
+
+        if (!atomic_load_explicit(&ve->failed, memory_order_relaxed))
+        {
+            if ((ve->format == VE_Y4M && !yuv) || ve_write_frame(ve, frame, yuv) < 0)
+                atomic_store_explicit(&ve->failed, true, memory_order_relaxed);
+            else
+                atomic_fetch_add_explicit(&ve->written, 1, memory_order_relaxed);
+        }
+
+        pthread_mutex_lock(&ve->lock);
+        ve->head = (ve->head + 1) % VE_SLOTS;
+        ve->queued -= 1;
+        pthread_cond_signal(&ve->wake);
+    }
+
+    pthread_mutex_unlock(&ve->lock);
+
+    fflush(ve->out);
+    free(yuv);
+
+    return NULL;
+}
+
+// Copies a mapped frame into a free slot for the writer; drops it if there's
+// none, unless asked to wait for one.
+static void
+ve_queue (struct video_exporter *ve, const void *frame, bool wait)
+{
+    pthread_mutex_lock(&ve->lock);
+
+    while (wait && ve->queued == VE_SLOTS)
+        pthread_cond_wait(&ve->wake, &ve->lock);
+
+    if (ve->queued == VE_SLOTS)
+    {
+        pthread_mutex_unlock(&ve->lock);
+        ve->dropped += 1;
+        return;
+    }
+
+    // Past the full ones, so the writer won't touch it until it's queued.
+    unsigned char *slot = ve->slots[(ve->head + ve->queued) % VE_SLOTS];
+    pthread_mutex_unlock(&ve->lock);
+
+    memcpy(slot, frame, (size_t)ve->width * ve->height * 4);
+
+    pthread_mutex_lock(&ve->lock);
+    ve->queued += 1;
+    pthread_cond_signal(&ve->wake);
+    pthread_mutex_unlock(&ve->lock);
+}
+
+// Hands on the frames whose readback has finished, oldest first, waiting for
+// the oldest `must` of them to finish if they haven't.
+static void
+ve_collect (struct video_exporter *ve, int must)
+{
+    const size_t size = (size_t)ve->width * ve->height * 4;
+
+    for (int i = 0; ve->pending > 0; ++i)
+    {
+        const bool wait = i < must;
+        GLsync *fence = &ve->fences[ve->first];
+        const GLenum status = glClientWaitSync(*fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                               wait ? GL_TIMEOUT_IGNORED : 0);
+
+        if (status == GL_TIMEOUT_EXPIRED)
+            break;
+
+        glDeleteSync(*fence);
+        *fence = NULL;
+
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, ve->pbos[ve->first]);
+        const void *frame = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+
+        if (frame)
+        {
+            ve_queue(ve, frame, wait || ve->lossless);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        } else
+            ve->dropped += 1;
+
+        ve->first = (ve->first + 1) % VE_BUFFERS;
+        ve->pending -= 1;
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+int
+ve_init (struct video_exporter *ve,
+         FILE *out,
+         enum ve_format format,
+         int width,
+         int height,
+         int fps,
+         bool lossless)
+{
+    const size_t size = (size_t)width * height * 4;
+
+    *ve = (struct video_exporter) {
+        .out = out,
+        .format = format,
+        .width = width,
+        .height = height,
+        .lossless = lossless,
+    };
+
+    if (format == VE_Y4M && (width % 2 != 0 || height % 2 != 0))
+        return -1;
+
+    for (int i = 0; i < VE_SLOTS; ++i)
+    {
+        ve->slots[i] = malloc(size);
+        if (!ve->slots[i])
+            goto error;
+    }
+
+    if (format == VE_Y4M &&
+        fprintf(out, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg XCOLORRANGE=LIMITED\n",
+                width, height, fps) < 0)
+        goto error;
+
+    if (pthread_mutex_init(&ve->lock, NULL) != 0)
+        goto error;
+
+    if (pthread_cond_init(&ve->wake, NULL) != 0)
+    {
+        pthread_mutex_destroy(&ve->lock);
+        goto error;
+    }
+
+    if (pthread_create(&ve->thread, NULL, ve_writer_run, ve) != 0)
+    {
+        pthread_cond_destroy(&ve->wake);
+        pthread_mutex_destroy(&ve->lock);
+        goto error;
+    }
+
+    glGenBuffers(VE_BUFFERS, ve->pbos);
+    for (int i = 0; i < VE_BUFFERS; ++i)
+    {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, ve->pbos[i]);
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    return 0;
+
+error:
+    for (int i = 0; i < VE_SLOTS; ++i)
+        free(ve->slots[i]);
+
+    return -1;
+}
+
+void
+ve_capture (struct video_exporter *ve, GLuint fbo)
+{
+    // With the GPU still behind on every buffer, the frame is dropped, unless
+    // the oldest one can be waited for.
+    ve_collect(ve, ve->lossless && ve->pending == VE_BUFFERS);
+
+    if (ve->pending == VE_BUFFERS)
+    {
+        ve->dropped += 1;
+        return;
+    }
+
+    const int i = (ve->first + ve->pending) % VE_BUFFERS;
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, ve->pbos[i]);
+    glReadPixels(0, 0, ve->width, ve->height, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    ve->fences[i] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    ve->pending += 1;
+}
+
+bool
+ve_failed (struct video_exporter *ve)
+{
+    return atomic_load_explicit(&ve->failed, memory_order_relaxed);
+}
+
+void
+ve_deinit (struct video_exporter *ve)
+{
+    ve_collect(ve, ve->pending);
+
+    pthread_mutex_lock(&ve->lock);
+    ve->quit = true;
+    pthread_cond_signal(&ve->wake);
+    pthread_mutex_unlock(&ve->lock);
+
+    pthread_join(ve->thread, NULL);
+
+    pthread_cond_destroy(&ve->wake);
+    pthread_mutex_destroy(&ve->lock);
+
+    glDeleteBuffers(VE_BUFFERS, ve->pbos);
+
+    for (int i = 0; i < VE_SLOTS; ++i)
+        free(ve->slots[i]);
+}
@@ -0,0 +1,91 @@
+/**
+ *   Copyright (C) 2025 Cynthia
+ *
+ *   This program is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <pthread.h>
+
+#include "gl.h"
+
+// Frames being read back into pixel-pack buffers; a frame is mapped this many
+// frames after it was drawn at most.
+#define VE_BUFFERS 3
+// Frames copied out and waiting for the writer.
+#define VE_SLOTS 3
+
+enum ve_format
+{
+    VE_Y4M,  // YUV 4:2:0, BT.601 limited range, for ffmpeg and the like.
+    VE_RGBA, // Raw 8-bit RGBA, top row first.
+};
+
+// Streams frames out of a framebuffer without ever waiting on the GPU or on
+// whoever reads them: glReadPixels goes into a ring of PBOs that are mapped
+// once their fences have passed, and the mapped frames are written out on a
+// thread of their own. Frames that would have to wait are dropped, and counted,
+// unless the exporter is `lossless`; then ve_capture() waits instead.
+struct video_exporter
+{
+    FILE *out;
+    enum ve_format format;
+    int width, height;
+    bool lossless;
+
+    GLuint pbos[VE_BUFFERS];
+    GLsync fences[VE_BUFFERS];
+    // Oldest buffer not yet mapped, and how many are being read into.
+    int first, pending;
+
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;
+
+    // Guarded by `lock`: the oldest slot the writer hasn't written yet, and
+    // how many are full.
+    unsigned char *slots[VE_SLOTS];
+    int head, queued;
+    bool quit;
+
+    // Written by the writer thread, which stops writing on the first error.
+    _Atomic unsigned long written;
+    _Atomic bool failed;
+    // Only touched by the render thread.
+    unsigned long dropped;
+};
+
+// Writes the stream header straight away. Y4M needs an even width and height.
+int
+ve_init (struct video_exporter *ve,
+         FILE *out,
+         enum ve_format format,
+         int width,
+         int height,
+         int fps,
+         bool lossless);
+
+// Starts reading the frame in `fbo` back, and hands on whatever earlier frames
+// have come in; never blocks, unless lossless.
+void
+ve_capture (struct video_exporter *ve, GLuint fbo);
+
+// Whether writing has failed, e.g. with the reader gone.
+bool
+ve_failed (struct video_exporter *ve);
+
+// Waits for the frames still in flight to be written, unlike ve_capture().
+void
+ve_deinit (struct video_exporter *ve);
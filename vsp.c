@@ -16,17 +16,37 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <math.h>
-#include <complex.h>
+#include <getopt.h>
+#include <limits.h>
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
 
 #include "renderer.h"
 
 #include <GLFW/glfw3.h>
 #include <pipewire/pipewire.h>
 
-#include <kiss_fftr.h>
-
+#include "analysis.h"
+#include "analyzer.h"
+#include "arena.h"
+#include "batch.h"
+#include "chroma.h"
+#include "command_queue.h"
+#include "gpu_fft.h"
+#include "gpu_timer.h"
+#include "headless.h"
+#include "loudness.h"
+#include "onset.h"
 #include "pipewire.h"
+#include "pitch.h"
+#include "program_cache.h"
+#include "scope.h"
+#include "video.h"
 
 /**
  * The following is a set of options that could be tweaked; choose carefully.
@@ -38,16 +58,26 @@ const int INIT_WIDTH = 1280;
 const int INIT_HEIGHT = 720;
 // Number of bins; controls the granularity of the spectrum.
 //
-// NOTE Number of points on the Mel spectrum to sample.
-const int NUM_POINTS = 360;
-// Number of MSAA samples; controls the strength of anti-aliasing.
-const int MSAA_HINT = 8;
+// NOTE Number of points on the Mel spectrum to sample; see also --points.
+const int DEFAULT_NUM_POINTS = 360;
+// GPU time a frame may take to draw and resolve with --aa=auto (in ms), not
+// counting the readback and swap; the strongest anti-aliasing that fits is
+// kept, stepping down from 8x MSAA to 4x, then FXAA, then none.
+const double AA_BUDGET_MS = 4.0;
+// How long --aa=auto times each mode before settling (in seconds).
+const double AA_PROBE_PERIOD = 1.0;
+// Height of the chroma strip along the bottom (in viewport units); see --chroma.
+const float CHROMA_STRIP_VH = 0.06;
 // Margin around the ends of the visualizer polygon (in viewport units).
 const float MARGIN_VW = 0.01;
 // Line-width to pass to OpenGL for drawing the polygon.
 //
 // NOTE This would scale automatically on window resize; see resize_callback()
 const float LINE_WIDTH = 1.75;
+// How often --gpu-time reports (in seconds).
+const double GPU_TIME_PERIOD = 2.0;
+// Frame rate of --headless, which has no display to sync to.
+const int HEADLESS_FPS = 60;
 // Initial gain of spectrum (in decibels).
 const float INIT_GAIN = 20.0;
 // Initial exponential smoothing factor (ranging from 0 to 1).
@@ -60,58 +90,269 @@ const float INIT_SMOOTHING_FACTOR = 0.7;
  * these because they're optimized for best results.
  */
 
-// Size of audio-ring buffer; controls the FFT analysis length.
-const int WINDOW_SIZE = 4096;
+// Size of audio-ring buffer; controls the FFT analysis length; see also --window-size.
+const int DEFAULT_WINDOW_SIZE = 4096;
+// Window sizes that [ and ] zoom between, by factors of two.
+const int ZOOM_MIN_WINDOW = 1024;
+const int ZOOM_MAX_WINDOW = 65536;
+// Largest deviation of the GPU FFT from kissfft (relative to the peak level) that
+// --gpu-fft accepts at startup; Q15 kissfft alone is off by about 3e-4.
+const float GPU_FFT_TOLERANCE = 1e-3;
+// Transforms timed on either side when --gpu-fft starts.
+const int GPU_FFT_BENCHMARK_RUNS = 64;
 // Sampling rate to capture audio at; however, it may/may not match the samplerate
 // configured for the PipeWire server, in such a case resampling will occur.
-const int SAMPLERATE = 48000;
-const int FFT_SIZE = WINDOW_SIZE / 2 + 1;
+const int DEFAULT_SAMPLERATE = 48000;
+
+struct vsp_options
+{
+    int window_size;
+    int num_points;
+    int sample_rate;
+    int huge_pages;
+    int loudness;
+    int chroma;
+    int pitch;
+    int scope;
+    // Rows of spectrum history drawn under it; 0 for none.
+    int waterfall;
+    int gpu_bands;
+    int gpu_fft;
+    int vertex_pull;
+    int aa_lines;
+    // An enum aa_mode, or AA_AUTO.
+    int aa;
+    int gpu_time;
+    int startup_trace;
+    // Windows to open; all but the first are views (see struct vsp_view).
+    int windows;
+    // Render into an FBO through EGL, with no window or display server, and
+    // at what size.
+    int headless;
+    int width, height;
+    // Where --headless streams its frames to, and as what; NULL for nowhere.
+    const char *export_path;
+    enum ve_format export_format;
+    // Where onset and beat events go; NULL if nobody wants them.
+    const char *events;
+
+    // Non-NULL for an offline --render of a file into --export.
+    const char *render_input;
+
+    // Non-NULL for a headless batch run over a file.
+    const char *batch_input;
+    const char *batch_output;
+    int jobs;
+};
 
 struct vsp_state
 {
     float tau, gain;
+    // Showing the triggered waveform instead of the spectrum; toggled with Tab.
+    int scope;
+
+    // Shown in the title, if metering, tracking pitch, or timing the GPU.
+    struct loudness_meter *meter;
+    struct pitch_detector *pitch;
+    struct gpu_timer *timer;
+
+    // Rebuilds the analysis for zooming; NULL if it can't be zoomed. `config`
+    // is the latest one asked for, which may not have been swapped in yet.
+    struct analysis_builder *builder;
+    struct analysis_config config;
+
+    // Framebuffer size, for the anti-aliasing buffers and the lines drawn by
+    // the shaders (--aa-lines); `resized` until they've been told.
+    int width, height;
+    int resized;
+    // Reported as 0x0; the last size is kept meanwhile.
+    int minimised;
+
+    // Where the event thread sends key presses, and the latest size the window
+    // was resized to; only the render thread changes anything above.
+    struct command_queue *commands;
+    struct cq_size size;
 };
 
-struct bin_range
+// Set by SIGINT and SIGTERM; --headless has no window to close.
+static volatile sig_atomic_t quit;
+
+static void
+quit_handler (int sig)
+{
+    quit = 1;
+}
+
+static double
+now (void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Set by --startup-trace; when main() started, on the now() clock.
+static int tracing;
+static double startup_time;
+
+// Marks the end of a startup phase; called from either thread of the setup.
+static void
+trace (const char *phase)
+{
+    if (tracing)
+        fprintf(stderr, "[%8.3f ms] %s\n", (now() - startup_time) * 1e3, phase);
+}
+
+// PipeWire is brought up on a thread of its own, while the main thread makes
+// the window and the context; neither needs the other until the stream is
+// connected.
+struct pw_setup
 {
-    float begin, end;
+    struct pipewire_backend *pwb;
+    struct pw_thread_loop *loop;
+    int ring_size, hop_size, sample_rate;
+    int ret;
 };
 
-// Genererates a von Hann window of length N.
+static void *
+pw_setup_run (void *arg)
+{
+    struct pw_setup *s = arg;
+
+    pw_init(NULL, NULL);
+    trace("pipewire: initialised");
+
+    s->loop = pw_thread_loop_new("pw-vsp", NULL);
+    pw_thread_loop_lock(s->loop);
+    pw_thread_loop_start(s->loop);
+    trace("pipewire: thread loop started");
+
+    s->ret = pipewire_backend_init(s->pwb,
+                                   pw_thread_loop_get_loop(s->loop),
+                                   "vsp",          /* app name */
+                                   s->ring_size,   /* ring buffer length */
+                                   s->hop_size,    /* hop length */
+                                   s->sample_rate);
+    pw_thread_loop_unlock(s->loop);
+    trace("pipewire: stream created");
+
+    return NULL;
+}
+
+// Points the program cache at $XDG_CACHE_HOME/vsp, or ~/.cache/vsp; programs
+// are linked every time with neither set, or if the driver won't cooperate.
 static void
-gen_hann_window(int N, float *win)
+init_program_cache (void)
 {
-    for (int i = 0; i < N; ++i)
-        win[i] = 0.5 * (1.0 - cosf(2.0 * M_PI * (float)i / N));
+    char dir[PATH_MAX];
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    const char *home = getenv("HOME");
+
+    // The spec has relative paths ignored.
+    if (xdg && xdg[0] == '/')
+        snprintf(dir, sizeof dir, "%s/vsp", xdg);
+    else if (home && home[0])
+        snprintf(dir, sizeof dir, "%s/.cache/vsp", home);
+    else
+        return;
+
+    pc_init(dir);
 }
 
+// What --gpu-time splits the frame into, in order.
+static const char *const FRAME_STAGES[] = {
+    "clear", "spectrum", "overlays", "resolve", "readback", "swap", "views"
+};
+#define NUM_FRAME_STAGES ((int)(sizeof FRAME_STAGES / sizeof *FRAME_STAGES))
+// What --aa=auto holds to AA_BUDGET_MS: clear to resolve, the stages it can
+// change, without the readback and swap.
+#define AA_STAGES 4
+
+// Indexed by enum aa_mode; also what --aa takes.
+static const char *const AA_NAMES[] = { "off", "fxaa", "msaa4", "msaa8" };
+#define AA_AUTO (-1)
+
 static inline
 float db_rms_to_power(float db)
 {
     return powf(10, M_SQRT2 * db / 20);
 }
 
-static inline
-float mel_to_freq(float mel)
+static void
+format_title (char *title, size_t size, struct vsp_state *s)
 {
-    return 700.0 * (expf(mel / 1127.0) - 1.0);
+    int len = snprintf(title, size, "vsp%s (N=%d, %.1f dB, τ=%.2f)",
+                       s->scope ? " scope" : "", s->config.window_size, s->gain, s->tau);
+
+    if (s->meter)
+        snprintf(title + len, size - len,
+                 " — M %.1f  S %.1f  I %.1f LUFS  TP %.1f dBTP",
+                 atomic_load_explicit(&s->meter->momentary, memory_order_relaxed),
+                 atomic_load_explicit(&s->meter->short_term, memory_order_relaxed),
+                 atomic_load_explicit(&s->meter->integrated, memory_order_relaxed),
+                 atomic_load_explicit(&s->meter->true_peak, memory_order_relaxed));
+
+    if (s->pitch && s->pitch->frequency > 0.0)
+    {
+        static const char *names[] = {
+            "C", "C♯", "D", "D♯", "E", "F", "F♯", "G", "G♯", "A", "A♯", "B"
+        };
+
+        const float note = 69.0 + 12.0 * log2f(s->pitch->frequency / 440.0);
+        const int nearest = lrintf(note);
+
+        len = strlen(title);
+        snprintf(title + len, size - len, " — %.1f Hz %s%d %+.0f¢",
+                 s->pitch->frequency, names[nearest % 12], nearest / 12 - 1,
+                 100.0 * (note - nearest));
+    }
+
+    if (s->timer && gt_percentile(s->timer, s->timer->num_stages, 50.0) >= 0.0)
+    {
+        len = strlen(title);
+        snprintf(title + len, size - len, " — GPU %.2f ms, p95 %.2f",
+                 gt_percentile(s->timer, s->timer->num_stages, 50.0),
+                 gt_percentile(s->timer, s->timer->num_stages, 95.0));
+    }
 }
 
 static void
 update_window_title (GLFWwindow *window, struct vsp_state *s)
 {
-    char title[32];
-    snprintf(title, sizeof title, "vsp (%.1f dB, τ=%.2f)", s->gain, s->tau);
+    char title[128];
 
+    format_title(title, sizeof title, s);
     glfwSetWindowTitle(window, title);
 }
 
+static void
+write_events (FILE *f, const struct onset_event *events, int num)
+{
+    for (int i = 0; i < num; ++i)
+    {
+        if (events[i].type == ONSET_EVENT_ONSET)
+            fprintf(f, "onset %.4f %.4f\n", events[i].time, events[i].value);
+        else
+            fprintf(f, "beat %.4f %.2f\n", events[i].time, events[i].value);
+    }
+}
+
 static void
 error_callback (int error, const char* desc)
 {
     fprintf(stderr, "GLFW error (%s) :(\n", desc);
 }
 
+// Runs on the event thread; what the keys ask for is only queued here, and
+// done by the render thread, in apply_command().
+static void
+send_command (struct vsp_state *s, enum cq_type type, int window, float delta)
+{
+    if (!cq_push(s->commands, &(struct cq_command) { .type = type, .window = window, .delta = delta }))
+        fprintf(stderr, "Command queue is full; a key was dropped :(\n");
+}
+
 static void
 key_callback (GLFWwindow* window, int key, int scancode, int action, int mods)
 {
@@ -122,203 +363,1800 @@ key_callback (GLFWwindow* window, int key, int scancode, int action, int mods)
         glfwSetWindowShouldClose(window, GLFW_TRUE);
     } else if (action == GLFW_PRESS || action == GLFW_REPEAT)
     {
-        #define clamp_min(x, min) (x) < (min) ? (min) : (x)
-        #define clamp_max(x, max) (x) > (max) ? (max) : (x)
-
         switch (key)
         {
             case GLFW_KEY_LEFT:
-                s->tau = clamp_min(s->tau - 0.01, 0);
+                send_command(s, CQ_TAU, 0, -0.01);
             break;
             case GLFW_KEY_RIGHT:
-                s->tau = clamp_max(s->tau + 0.01, 1);
+                send_command(s, CQ_TAU, 0, 0.01);
             break;
             case GLFW_KEY_UP:
-                s->gain += 0.1;
+                send_command(s, CQ_GAIN, 0, 0.1);
             break;
             case GLFW_KEY_DOWN:
-                s->gain -= 0.1;
+                send_command(s, CQ_GAIN, 0, -0.1);
+            break;
+            case GLFW_KEY_TAB:
+                if (action == GLFW_PRESS)
+                    send_command(s, CQ_SCOPE, 0, 0.0);
+            break;
+            case GLFW_KEY_LEFT_BRACKET:
+                send_command(s, CQ_ZOOM, 0, -1.0);
+            break;
+            case GLFW_KEY_RIGHT_BRACKET:
+                send_command(s, CQ_ZOOM, 0, 1.0);
             break;
         }
+    }
+}
+
+// Spreads the points evenly between the margins.
+static void
+place_points (struct vertex *points, int num_points)
+{
+    const float X_STEP = 2.0 * (1.0 - MARGIN_VW) / num_points;
+    float x = -1.0 + MARGIN_VW;
 
-        update_window_title(window, s);
+    for (int i = 0; i < num_points; ++i)
+    {
+        points[i].x = x;
+        x += X_STEP;
     }
 }
 
 static void
 resize_callback(GLFWwindow* window, int width, int height)
 {
-    glViewport(0, 0, width, height);
-    glLineWidth(LINE_WIDTH / INIT_WIDTH * width);
+    struct vsp_state *s = glfwGetWindowUserPointer(window);
+
+    // A live resize fires this for every step of the drag; the render thread
+    // only takes the last of them, at the start of its next frame.
+    cq_size_set(&s->size, width, height);
 }
 
-int main()
+// A window past the first (--windows), on a context sharing its objects. The
+// analysis is done and uploaded once a frame, in the first window's context;
+// views only draw it, from the same buffers. Vertex arrays and framebuffers
+// aren't shared between contexts, so each view has renderers of its own.
+struct vsp_view
 {
-    GLFWwindow *window = NULL;
+    GLFWwindow *window;
+    // Takes every key but Tab.
+    GLFWwindow *first;
+    // In the commands it sends; see struct cq_command.
+    int index;
+    int scope;
+
+    struct level_renderer levels;
+    struct waveform_renderer scope_trace;
+    struct strip_renderer chroma_strip;
+    struct marker_renderer pitch_marker;
+    struct waterfall_renderer waterfall;
+    struct aa_pass aa;
+
+    // As in struct vsp_state; nothing is done about a resize until the view
+    // is drawn, with its own context current.
+    int width, height;
+    int resized;
+    struct cq_size size;
+};
 
-    struct polygon_renderer pr;
-    struct pipewire_backend pwb;
-    struct pw_thread_loop *loop;
+// What every view draws from in a frame.
+struct view_frame
+{
+    GLuint levels_texture;
+    const struct waveform_renderer *scope_trace;
+    float gain;
+    // NULL for none.
+    const float *marker_x;
+    const float *chroma;
+    const struct waterfall_renderer *waterfall;
+    enum aa_mode aa_mode;
+    // Signalled once the first window has uploaded everything above.
+    GLsync published;
+};
 
-    int ret;
+static void
+view_key_callback (GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    struct vsp_view *v = glfwGetWindowUserPointer(window);
 
-    kiss_fftr_cfg fft;
-    float sample_win[WINDOW_SIZE];
-    float hann_win[WINDOW_SIZE];
-    kiss_fft_cpx freq_bins[FFT_SIZE];
+    if (key == GLFW_KEY_TAB)
+    {
+        if (action == GLFW_PRESS)
+            send_command(glfwGetWindowUserPointer(v->first), CQ_SCOPE, v->index, 0.0);
+    } else
+        key_callback(v->first, key, scancode, action, mods);
+}
 
-    struct bin_range ranges[NUM_POINTS];
-    struct vertex points[NUM_POINTS + 1];
-    // Exponential smoothing is applied on freq_bins.
-    float sm_freqs[NUM_POINTS];
+static void
+view_resize_callback (GLFWwindow* window, int width, int height)
+{
+    struct vsp_view *v = glfwGetWindowUserPointer(window);
 
-    struct vsp_state state = {
-        .gain = INIT_GAIN,
-        .tau = INIT_SMOOTHING_FACTOR,
-    };
+    cq_size_set(&v->size, width, height);
+}
 
-    glfwInit();
-    pw_init(NULL, NULL);
+// Opens `num` views after `first`, each centred on a monitor of its own while
+// there are enough to go round; `first` is current again on return.
+static int
+open_views (struct vsp_view *views,
+            int num,
+            GLFWwindow *first,
+            const struct vsp_options *opts,
+            enum aa_mode aa_mode)
+{
+    int num_monitors = 0;
+    GLFWmonitor **monitors = glfwGetMonitors(&num_monitors);
+    int ret = 0;
 
-    glfwSetErrorCallback(error_callback);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-    glfwWindowHint(GLFW_SAMPLES, MSAA_HINT);
+    // Shown only once they're in place.
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
-    loop = pw_thread_loop_new("pw-vsp", NULL);
-    pw_thread_loop_lock(loop);
-    pw_thread_loop_start(loop);
-
-    ret = pipewire_backend_init(&pwb,
-                                pw_thread_loop_get_loop(loop),
-                                "vsp",           /* app name */
-                                WINDOW_SIZE,     /* ring buffer length */
-                                WINDOW_SIZE / 2, /* hop length */
-                                SAMPLERATE);
-    if (ret != 0)
+    for (int i = 0; i < num; ++i)
     {
-        fputs("PipeWire backend initialisation failed :(", stderr);
-        goto error;
+        struct vsp_view *v = &views[i];
+
+        v->window = glfwCreateWindow(INIT_WIDTH, INIT_HEIGHT, "vsp", NULL, first);
+        if (!v->window)
+        {
+            ret = -1;
+            break;
+        }
+
+        v->first = first;
+        v->index = i + 1;
+        v->scope = opts->scope;
+        cq_size_init(&v->size);
+
+        GLFWmonitor *monitor = num_monitors > 1 ? monitors[(i + 1) % num_monitors] : NULL;
+        const GLFWvidmode *mode = monitor ? glfwGetVideoMode(monitor) : NULL;
+
+        if (mode)
+        {
+            int x, y;
+
+            glfwGetMonitorPos(monitor, &x, &y);
+            glfwSetWindowPos(v->window, x + (mode->width - INIT_WIDTH) / 2,
+                             y + (mode->height - INIT_HEIGHT) / 2);
+        }
+
+        glfwSetWindowUserPointer(v->window, v);
+        glfwSetKeyCallback(v->window, view_key_callback);
+        glfwSetFramebufferSizeCallback(v->window, view_resize_callback);
+        glfwShowWindow(v->window);
+
+        glfwMakeContextCurrent(v->window);
+        // Only the first window waits for vsync, or every view would wait again.
+        glfwSwapInterval(0);
+        glfwGetFramebufferSize(v->window, &v->width, &v->height);
+        v->resized = 1;
+
+        // In the format of whatever the first window uploads them from.
+#ifdef VSP_FIXED_POINT
+        if (!opts->gpu_bands)
+            lr_init(&v->levels, opts->num_points, GL_R32I, 1.0 / 32768, MARGIN_VW, opts->aa_lines);
+        else
+#endif
+            lr_init(&v->levels, opts->num_points, GL_R32F, 1.0, MARGIN_VW, opts->aa_lines);
+#ifdef VSP_FIXED_POINT
+        wr_init(&v->scope_trace, GL_SHORT, MARGIN_VW);
+#else
+        wr_init(&v->scope_trace, GL_FLOAT, MARGIN_VW);
+#endif
+        if (opts->chroma)
+            sr_init(&v->chroma_strip, CHROMA_CLASSES, 2.0 * CHROMA_STRIP_VH);
+        if (opts->pitch)
+            mr_init(&v->pitch_marker);
+        // Draws the first window's history; it keeps none of its own.
+        if (opts->waterfall)
+            wf_init(&v->waterfall, opts->num_points, 0, GL_R32F, 1.0, MARGIN_VW);
+        aa_init(&v->aa, aa_mode, 0, v->width, v->height);
     }
 
-    gen_hann_window(WINDOW_SIZE, hann_win);
-    fft = kiss_fftr_alloc(WINDOW_SIZE, 0, NULL, NULL);
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+    glfwMakeContextCurrent(first);
 
-    window = glfwCreateWindow(INIT_WIDTH, INIT_HEIGHT, "vsp", NULL, NULL);
-    if (!window)
-        goto error;
+    return ret;
+}
+
+static void
+draw_view (struct vsp_view *v, const struct view_frame *f, const struct vsp_options *opts)
+{
+    glfwMakeContextCurrent(v->window);
+    glWaitSync(f->published, 0, GL_TIMEOUT_IGNORED);
+
+    // The first window may have stepped its anti-aliasing down; views follow.
+    if (v->aa.mode != f->aa_mode)
+    {
+        aa_deinit(&v->aa);
+        aa_init(&v->aa, f->aa_mode, 0, v->width, v->height);
+    }
+
+    if (v->resized)
+    {
+        glViewport(0, 0, v->width, v->height);
+        glLineWidth(LINE_WIDTH / INIT_WIDTH * v->width);
+        if (opts->aa_lines)
+            lr_set_line(&v->levels, LINE_WIDTH / INIT_WIDTH * v->width, v->width, v->height);
+        aa_resize(&v->aa, v->width, v->height);
+        v->resized = 0;
+    }
 
-    glfwSetWindowUserPointer(window, &state);
-    update_window_title(window, &state);
+    aa_begin(&v->aa);
 
-    glfwSetKeyCallback(window, key_callback);
-    glfwSetFramebufferSizeCallback(window, resize_callback);
-    glfwMakeContextCurrent(window); // Set the OpenGL context.
-    glfwSwapInterval(1); // Enable VSync.
-    gladLoadGL(glfwGetProcAddress);
+    if (!v->scope && f->waterfall)
+        wf_draw_from(&v->waterfall, f->waterfall, db_rms_to_power(f->gain));
 
-    // Generate x-coords; do it here because if it were to be done in the hot-loop,
-    // it would be a waste of CPU cycles.
-    const float X_STEP = 2.0 * (1.0 - MARGIN_VW) / NUM_POINTS;
-    float x = -1.0 + MARGIN_VW;
+    if (v->scope)
+        wr_draw_from(&v->scope_trace, f->scope_trace, powf(10, (f->gain - INIT_GAIN) / 20));
+    else
+        lr_draw_from(&v->levels, f->levels_texture, db_rms_to_power(f->gain));
+
+    if (!v->scope && f->marker_x)
+        mr_draw(&v->pitch_marker, *f->marker_x);
+    if (f->chroma)
+        sr_draw(&v->chroma_strip, f->chroma);
 
-    for (int i = 0; i < NUM_POINTS; ++i)
+    aa_end(&v->aa);
+    glfwSwapBuffers(v->window);
+}
+
+// Closing any of the windows closes them all.
+static int
+views_closed (const struct vsp_view *views, int num)
+{
+    for (int i = 0; i < num; ++i)
+        if (glfwWindowShouldClose(views[i].window))
+            return 1;
+
+    return 0;
+}
+
+// Each with its own context current, as its objects are deleted.
+static void
+close_views (struct vsp_view *views, int num, const struct vsp_options *opts)
+{
+    for (int i = 0; i < num && views[i].window; ++i)
     {
-        points[i].x = x;
-        x += X_STEP;
+        struct vsp_view *v = &views[i];
+
+        glfwMakeContextCurrent(v->window);
+        lr_deinit(&v->levels);
+        wr_deinit(&v->scope_trace);
+        if (opts->chroma)
+            sr_deinit(&v->chroma_strip);
+        if (opts->pitch)
+            mr_deinit(&v->pitch_marker);
+        if (opts->waterfall)
+            wf_deinit(&v->waterfall);
+        aa_deinit(&v->aa);
+
+        glfwDestroyWindow(v->window);
+    }
+}
+
+static void
+usage (const char *argv0)
+{
+    fprintf(stderr,
+            "Usage: %s [OPTION]...\n"
+            "  -w, --window-size=N  FFT analysis length (even, 64-65536; default %d)\n"
+            "  -p, --points=N       points on the Mel spectrum (3-8192; default %d)\n"
+            "  -r, --samplerate=N   capture sample rate in Hz (default %d)\n"
+            "  -W, --windows=N      open N windows (1-16), one per monitor, all showing the\n"
+            "                       same analysis; Tab switches each on its own (implies -V\n"
+            "                       unless -g)\n"
+            "  -H, --huge-pages     back the analysis arena with huge pages\n"
+            "  -e, --events=FILE    write onset and beat events to FILE (- for stdout)\n"
+            "  -L, --loudness       show EBU R128 loudness and true-peak in the title\n"
+            "  -c, --chroma         show a chromagram strip under the spectrum\n"
+            "  -P, --pitch          mark the fundamental on the spectrum, and name it in the title\n"
+            "  -s, --scope          start with the triggered waveform (Tab switches)\n"
+            "  -F, --waterfall=N    draw the last N spectra (16-16384) under the spectrum,\n"
+            "                       newest at the top, one a hop\n"
+            "  -g, --gpu-bands      fold and smooth the spectrum on the GPU\n"
+            "  -G, --gpu-fft        also take the FFT on the GPU (OpenGL 4.3 compute shaders;\n"
+            "                       checked against kissfft, and timed, at startup)\n"
+            "  -V, --vertex-pull    upload only the band levels, and build the spectrum from\n"
+            "                       them in the vertex shader\n"
+            "  -A, --aa-lines       draw the spectrum as thick, analytically anti-aliased\n"
+            "                       lines, without MSAA (implies -V unless -g)\n"
+            "  -a, --aa=MODE        anti-aliasing: msaa8, msaa4, fxaa, off, or auto to pick\n"
+            "                       the strongest drawing a frame in %.0f ms of GPU time\n"
+            "                       (default: auto; off with --aa-lines)\n"
+            "  -T, --gpu-time       report percentiles of the GPU time each stage of the\n"
+            "                       frame takes, and show the total in the title\n"
+            "  -t, --startup-trace  print when each phase of startup ends, up to the\n"
+            "                       first frame\n"
+            "  -n, --headless       render frames off-screen through EGL, with no window or\n"
+            "                       display server, until interrupted\n"
+            "  -S, --size=WxH       size of the headless frames (default %dx%d)\n"
+            "  -x, --export=FILE    stream the frames to FILE (- for stdout); implies -n\n"
+            "  -f, --format=FORMAT  what --export writes: y4m (default), or rgba for raw\n"
+            "                       8-bit RGBA at %d fps\n"
+            "  -R, --render=FILE    render a raw mono %s file (at --samplerate) into\n"
+            "                       --export as fast as it goes, with no frames dropped\n"
+            "\n"
+            "  -b, --batch=FILE     write the Mel peak spectrum of a raw mono %s file\n"
+            "                       (at --samplerate) as a frames x points float32 matrix\n"
+            "  -o, --output=FILE    where --batch writes to (default: stdout)\n"
+            "  -j, --jobs=N         threads for --batch and --render (default: all cores)\n"
+            "\n"
+            "  -h, --help           show this help\n"
+            "\n"
+            "VSP_WINDOW_SIZE, VSP_POINTS, VSP_SAMPLERATE, VSP_WINDOWS, VSP_WATERFALL and\n"
+            "VSP_HUGE_PAGES=1 set the same options; the command line takes precedence.\n",
+            argv0, DEFAULT_WINDOW_SIZE, DEFAULT_NUM_POINTS, DEFAULT_SAMPLERATE, AA_BUDGET_MS,
+            INIT_WIDTH, INIT_HEIGHT, HEADLESS_FPS,
+#ifdef VSP_FIXED_POINT
+            "s16",
+#else
+            "f32",
+#endif
+#ifdef VSP_FIXED_POINT
+            "s16"
+#else
+            "f32"
+#endif
+            );
+}
 
-        const float DELTA_MEL = 3785.184764; // 1127 * ln((20000.0 + 700.0) / (20.0 + 700.0))
-        const float MEL_MIN = 31.748578; // 1127.0 * ln(1.0 + 20.0/700.0)
-        const float BIN_WIDTH = (float)WINDOW_SIZE / SAMPLERATE;
+// 0 for success; <0 if `arg` isn't an integer within [min, max].
+static int
+parse_int (const char *name, const char *arg, int min, int max, int *out)
+{
+    char *end;
+    long v = strtol(arg, &end, 10);
 
-        #define index_to_mel(i) (DELTA_MEL * (float)(i) / NUM_POINTS + MEL_MIN)
+    if (*arg == '\0' || *end != '\0' || v < min || v > max)
+    {
+        fprintf(stderr, "Invalid %s '%s'; expected %d-%d :(\n", name, arg, min, max);
+        return -1;
+    }
 
-        ranges[i] = (struct bin_range) {
-            .begin = mel_to_freq(index_to_mel(i)) * BIN_WIDTH,
-            .end = mel_to_freq(index_to_mel(i+1)) * BIN_WIDTH + 1.0
-        };
+    *out = v;
+    return 0;
+}
+
+// 0 for success; <0 for failure; >0 if the program should just exit.
+static int
+parse_options (int argc, char **argv, struct vsp_options *opts)
+{
+    static const struct option long_opts[] = {
+        { "window-size", required_argument, NULL, 'w' },
+        { "points",      required_argument, NULL, 'p' },
+        { "samplerate",  required_argument, NULL, 'r' },
+        { "windows",     required_argument, NULL, 'W' },
+        { "huge-pages",  no_argument,       NULL, 'H' },
+        { "events",      required_argument, NULL, 'e' },
+        { "loudness",    no_argument,       NULL, 'L' },
+        { "chroma",      no_argument,       NULL, 'c' },
+        { "pitch",       no_argument,       NULL, 'P' },
+        { "scope",       no_argument,       NULL, 's' },
+        { "waterfall",   required_argument, NULL, 'F' },
+        { "gpu-bands",   no_argument,       NULL, 'g' },
+        { "gpu-fft",     no_argument,       NULL, 'G' },
+        { "vertex-pull", no_argument,       NULL, 'V' },
+        { "aa-lines",    no_argument,       NULL, 'A' },
+        { "aa",          required_argument, NULL, 'a' },
+        { "gpu-time",    no_argument,       NULL, 'T' },
+        { "startup-trace", no_argument,     NULL, 't' },
+        { "headless",    no_argument,       NULL, 'n' },
+        { "export",      required_argument, NULL, 'x' },
+        { "format",      required_argument, NULL, 'f' },
+        { "size",        required_argument, NULL, 'S' },
+        { "render",      required_argument, NULL, 'R' },
+        { "batch",       required_argument, NULL, 'b' },
+        { "output",      required_argument, NULL, 'o' },
+        { "jobs",        required_argument, NULL, 'j' },
+        { "help",        no_argument,       NULL, 'h' },
+        { 0 }
+    };
+
+    struct {
+        const char *env, *name;
+        int opt, min, max;
+        int *out;
+    } params[] = {
+        { "VSP_WINDOW_SIZE", "window size", 'w', 64,   65536,  &opts->window_size },
+        { "VSP_POINTS",      "point count", 'p', 3,    8192,   &opts->num_points },
+        { "VSP_SAMPLERATE",  "sample rate", 'r', 8000, 384000, &opts->sample_rate },
+        { "VSP_HUGE_PAGES",  NULL,          0,   0,    1,      &opts->huge_pages },
+        { "VSP_JOBS",        "job count",   'j', 1,    1024,   &opts->jobs },
+        { "VSP_WINDOWS",     "window count", 'W', 1,   16,     &opts->windows },
+        { "VSP_WATERFALL",   "history length", 'F', 16, 16384, &opts->waterfall },
+    };
+    const int num_params = sizeof params / sizeof *params;
+
+    *opts = (struct vsp_options) {
+        .window_size = DEFAULT_WINDOW_SIZE,
+        .num_points = DEFAULT_NUM_POINTS,
+        .sample_rate = DEFAULT_SAMPLERATE,
+        .batch_output = "-",
+        .jobs = sysconf(_SC_NPROCESSORS_ONLN),
+        .windows = 1,
+        .aa = AA_AUTO,
+        .width = INIT_WIDTH,
+        .height = INIT_HEIGHT,
+    };
+    int aa_given = 0;
+
+    // Environment first, so that the command line can override it.
+    for (int i = 0; i < num_params; ++i)
+    {
+        const char *v = getenv(params[i].env);
+
+        if (v && parse_int(params[i].env, v, params[i].min, params[i].max, params[i].out) < 0)
+            return -1;
     }
 
-    pr_init(&pr);
-    glLineWidth(LINE_WIDTH);
+    int c;
+    while ((c = getopt_long(argc, argv, "w:p:r:W:He:LcPsF:gGVAa:Ttnx:f:S:R:b:o:j:h", long_opts, NULL)) != -1)
+    {
+        int i = 0;
+        while (i < num_params && params[i].opt != c)
+            ++i;
 
-    ret = pipewire_backend_connect(&pwb);
-    if (ret != 0)
+        if (i < num_params)
+        {
+            if (parse_int(params[i].name, optarg, params[i].min, params[i].max, params[i].out) < 0)
+                return -1;
+        } else if (c == 'H')
+        {
+            opts->huge_pages = 1;
+        } else if (c == 'L')
+        {
+            opts->loudness = 1;
+        } else if (c == 'c')
+        {
+            opts->chroma = 1;
+        } else if (c == 'P')
+        {
+            opts->pitch = 1;
+        } else if (c == 's')
+        {
+            opts->scope = 1;
+        } else if (c == 'g')
+        {
+            opts->gpu_bands = 1;
+        } else if (c == 'G')
+        {
+            // The bins stay on the GPU, so the bands have to be folded there too.
+            opts->gpu_fft = 1;
+            opts->gpu_bands = 1;
+        } else if (c == 'V')
+        {
+            opts->vertex_pull = 1;
+        } else if (c == 'A')
+        {
+            // Only the shaders that pull the levels know how to draw them.
+            opts->aa_lines = 1;
+            opts->vertex_pull = 1;
+        } else if (c == 'a')
+        {
+            opts->aa = AA_AUTO;
+            aa_given = 1;
+
+            if (strcmp(optarg, "auto") != 0)
+            {
+                int i = 0;
+                while (i <= AA_MSAA8 && strcmp(optarg, AA_NAMES[i]) != 0)
+                    ++i;
+
+                if (i > AA_MSAA8)
+                {
+                    fprintf(stderr, "Unknown anti-aliasing mode '%s' :(\n", optarg);
+                    return -1;
+                }
+
+                opts->aa = i;
+            }
+        } else if (c == 'T')
+        {
+            opts->gpu_time = 1;
+        } else if (c == 't')
+        {
+            opts->startup_trace = 1;
+        } else if (c == 'n')
+        {
+            opts->headless = 1;
+        } else if (c == 'x')
+        {
+            // Frames are read back from the headless FBO, which doesn't change size.
+            opts->export_path = optarg;
+            opts->headless = 1;
+        } else if (c == 'S')
+        {
+            char end;
+
+            // Y4M halves both for the chroma.
+            if (sscanf(optarg, "%dx%d%c", &opts->width, &opts->height, &end) != 2 ||
+                opts->width < 16 || opts->width > 16384 || opts->width % 2 != 0 ||
+                opts->height < 16 || opts->height > 16384 || opts->height % 2 != 0)
+            {
+                fprintf(stderr, "Size must be WxH, even, and 16-16384 each way :(\n");
+                return -1;
+            }
+        } else if (c == 'R')
+        {
+            opts->render_input = optarg;
+        } else if (c == 'f')
+        {
+            if (strcmp(optarg, "y4m") == 0)
+                opts->export_format = VE_Y4M;
+            else if (strcmp(optarg, "rgba") == 0)
+                opts->export_format = VE_RGBA;
+            else
+            {
+                fprintf(stderr, "Unknown export format '%s' :(\n", optarg);
+                return -1;
+            }
+        } else if (c == 'e')
+        {
+            opts->events = optarg;
+        } else if (c == 'b')
+        {
+            opts->batch_input = optarg;
+        } else if (c == 'o')
+        {
+            opts->batch_output = optarg;
+        } else if (c == 'h')
+        {
+            usage(argv[0]);
+            return 1;
+        } else
+        {
+            usage(argv[0]);
+            return -1;
+        }
+    }
+
+    if (opts->render_input && !opts->export_path)
     {
-        fputs ("PipeWire stream connection failed :(\n", stderr);
+        fprintf(stderr, "--render needs somewhere to --export to :(\n");
+        return -1;
+    }
+
+    if (opts->windows > 1 && opts->headless)
+    {
+        fprintf(stderr, "--windows needs a display; it can't go with --headless :(\n");
+        return -1;
+    }
+
+    // The other windows draw the levels the first one uploads; the polygon
+    // renderer keeps its vertices to itself.
+    if (opts->windows > 1)
+        opts->vertex_pull = 1;
+
+    if (opts->export_path && opts->events &&
+        strcmp(opts->export_path, "-") == 0 && strcmp(opts->events, "-") == 0)
+    {
+        fprintf(stderr, "Events and frames can't both go to stdout :(\n");
+        return -1;
+    }
+
+    // The lines anti-alias themselves, so they don't need any more of it,
+    // unless asked for.
+    if (opts->aa_lines && !aa_given)
+        opts->aa = AA_OFF;
+
+    // Real-input FFTs need an even length.
+    if (opts->window_size % 2 != 0)
+    {
+        fprintf(stderr, "Window size must be even :(\n");
+        return -1;
+    }
+
+#ifdef VSP_FIXED_POINT
+    if (opts->pitch)
+    {
+        fprintf(stderr, "Pitch tracking needs a floating-point build :(\n");
+        return -1;
+    }
+#endif
+
+    return 0;
+}
+
+// --render: the whole file is analysed up front on every core, one frame of
+// levels per video frame, and the frames are then drawn and streamed out as
+// fast as they go. Only the spectrum is drawn; the trackers and the GPU paths
+// need the audio a hop at a time.
+static int
+render_file (const struct vsp_options *opts)
+{
+    struct headless_context hc = { 0 };
+    struct level_renderer levels;
+    struct waterfall_renderer waterfall;
+    struct aa_pass aa;
+    struct video_exporter ve;
+    float *frames = NULL, *smoothed = NULL;
+    FILE *out = NULL;
+    int rendering = 0, exporting = 0;
+    // --waterfall, unless its history couldn't be made.
+    int waterfall_shown = 0;
+    size_t len = 0;
+    int ret = -1;
+
+    const kiss_fft_scalar *samples = batch_map(opts->render_input, &len);
+    if (!samples)
+        return -1;
+
+    // One analysis frame per video frame; off by a fraction of a sample a
+    // frame at rates that don't divide evenly.
+    const int hop = lrint((double)opts->sample_rate / HEADLESS_FPS);
+    const size_t num_frames = batch_num_frames(len, opts->window_size, hop);
+
+    if (num_frames == 0)
+    {
+        fprintf(stderr, "%s: shorter than one window :(\n", opts->render_input);
         goto error;
     }
 
-    pw_thread_loop_unlock(loop);
+    frames = malloc(num_frames * opts->num_points * sizeof(float));
+    smoothed = calloc(opts->num_points, sizeof(float));
+    if (!frames || !smoothed)
+        goto error;
 
-    while (!glfwWindowShouldClose(window))
+    const double start = now();
+
+    if (batch_analyze(samples, len, hop, opts->window_size, opts->num_points,
+                      opts->sample_rate, opts->jobs, frames) != 0)
     {
-        glfwPollEvents();
+        fputs("Batch analysis failed :(\n", stderr);
+        goto error;
+    }
 
-        pw_thread_loop_lock(loop);
-        pipewire_backend_capture(&pwb, sample_win);
-        pw_thread_loop_unlock(loop);
+    const double analysed = now();
 
-        // Tapering the window.
-        for (int i = 0; i < WINDOW_SIZE; ++i)
-            sample_win[i] *= hann_win[i];
+    out = strcmp(opts->export_path, "-") == 0 ? stdout : fopen(opts->export_path, "wb");
+    if (!out)
+    {
+        perror(opts->export_path);
+        goto error;
+    }
 
-        // FFT.
-        kiss_fftr(fft, sample_win, freq_bins);
+    if (hc_init(&hc, 3, 3, opts->width, opts->height) != 0)
+    {
+        fputs("Headless OpenGL context creation failed :(\n", stderr);
+        goto error;
+    }
 
-        const float gain = db_rms_to_power(state.gain);
+    init_program_cache();
 
-        static const float FFT_SCALE = 2.0 / WINDOW_SIZE;
+    // With no frame budget to probe, auto goes for the lines that anti-alias
+    // themselves; a CPU rasteriser gets through them far quicker than MSAA.
+    const int aa_lines = opts->aa_lines || opts->aa == AA_AUTO;
+    enum aa_mode aa_mode = opts->aa == AA_AUTO ? AA_OFF : opts->aa;
+    const float line_width = LINE_WIDTH / INIT_WIDTH * hc.width;
 
-        for (int i = 0; i < NUM_POINTS; ++i)
-        {
-            const int bbegin = ranges[i].begin;
-            const int bdelta = ranges[i].end - ranges[i].begin;
+    lr_init(&levels, opts->num_points, GL_R32F, 1.0, MARGIN_VW, aa_lines);
+    if (aa_lines)
+        lr_set_line(&levels, line_width, hc.width, hc.height);
+    glLineWidth(line_width);
 
-            float mag = 0.0;
-            complex float bin;
+    while (aa_init(&aa, aa_mode, hc.fbo, hc.width, hc.height) < 0)
+    {
+        fprintf(stderr, "Anti-aliasing with %s isn't supported; trying %s :(\n",
+                AA_NAMES[aa_mode], AA_NAMES[aa_mode - 1]);
+        aa_mode -= 1;
+    }
+    rendering = 1;
 
-            for (int bi = 0; bi < bdelta; ++bi)
-            {
-                bin = *(complex float*)&freq_bins[bbegin + bi];
+    if (opts->waterfall)
+    {
+        waterfall_shown = wf_init(&waterfall, opts->num_points, opts->waterfall,
+                                  GL_R32F, 1.0, MARGIN_VW) == 0;
+        if (!waterfall_shown)
+            fputs("Waterfall initialisation failed; it's off :(\n", stderr);
+    }
 
-                // Find the most dominant tone; band averaging is not desired,
-                // that would be computing power spectra, and not tone spectra.
-                mag = fmaxf(mag, FFT_SCALE * cabsf(bin));
-            }
+    if (ve_init(&ve, out, opts->export_format, hc.width, hc.height, HEADLESS_FPS, true) != 0)
+    {
+        fputs("Video export initialisation failed :(\n", stderr);
+        goto error;
+    }
+    exporting = 1;
 
-            // Exponential time-smoothing to make animation smoother.
-            sm_freqs[i] = sm_freqs[i] * state.tau + (1.0 - state.tau) * mag;
+    // The live view smooths once every half a window; this is the same time
+    // constant, taken a frame at a time.
+    const float tau = powf(INIT_SMOOTHING_FACTOR, (float)hop / (opts->window_size / 2));
+    const float gain = db_rms_to_power(INIT_GAIN);
 
-            // points[i + 1].y = gain * sign * sm_freqs[i];
-        }
+    for (size_t f = 0; f < num_frames && !ve_failed(&ve); ++f)
+    {
+        const float *row = &frames[f * opts->num_points];
 
-        float sign = 1.0;
+        for (int i = 0; i < opts->num_points; ++i)
+            smoothed[i] = smoothed[i] * tau + (1.0 - tau) * row[i];
 
-        // Smoothing operation
-        for(int i = 1; i < NUM_POINTS-1; ++i)
+        aa_begin(&aa);
+        if (waterfall_shown)
         {
-            float pv = sm_freqs[i-1] * 0.225 + sm_freqs[i] * 0.56 + sm_freqs[i+1] * 0.225;
-            points[i].y = sign * gain * pv;
-
-            // Flipping sign creates the characteristic saw pattern.
-            sign = -sign;
+            wf_push(&waterfall, smoothed);
+            wf_draw(&waterfall, gain);
         }
+        lr_upload(&levels, smoothed);
+        lr_draw(&levels, gain);
+        aa_end(&aa);
 
-        pr_draw(&pr, points, NUM_POINTS);
-        glfwSwapBuffers(window);
+        ve_capture(&ve, hc.fbo);
     }
 
-    pw_thread_loop_stop(loop);
+    ve_deinit(&ve);
+    exporting = 0;
+
+    if (ve_failed(&ve))
+    {
+        fputs("Video export failed to write :(\n", stderr);
+        goto error;
+    }
+
+    const double rendered = now();
 
+    fprintf(stderr, "%zu frames at %dx%d in %.3f s (analysis %.3f s on %d threads); "
+            "%.0f frames/s, %.1fx real time\n",
+            num_frames, hc.width, hc.height, rendered - start, analysed - start, opts->jobs,
+            num_frames / (rendered - start),
+            (double)num_frames / HEADLESS_FPS / (rendered - start));
+
+    ret = 0;
 error:
-    if (window)
-        glfwDestroyWindow(window);
+    if (exporting)
+        ve_deinit(&ve);
+    if (rendering)
+    {
+        if (waterfall_shown)
+            wf_deinit(&waterfall);
+        aa_deinit(&aa);
+        lr_deinit(&levels);
+    }
+    hc_deinit(&hc);
+
+    if (out && out != stdout)
+        fclose(out);
 
-    pr_deinit(&pr);
+    free(smoothed);
+    free(frames);
+    batch_unmap(samples, len);
+
+    return ret;
+}
+
+// Does what the event thread asked for, on the render thread, with the first
+// window's context current; true if the title has to change.
+static int
+apply_command (struct vsp_state *s, struct vsp_view *views, const struct cq_command *cmd)
+{
+    struct vsp_view *v = cmd->window ? &views[cmd->window - 1] : NULL;
+
+    switch (cmd->type)
+    {
+        case CQ_GAIN:
+            s->gain += cmd->delta;
+        break;
+        case CQ_TAU:
+            s->tau = fminf(fmaxf(s->tau + cmd->delta, 0.0), 1.0);
+        break;
+        case CQ_SCOPE:
+            if (v)
+            {
+                v->scope = !v->scope;
+                return 0;
+            }
+
+            s->scope = !s->scope;
+        break;
+        case CQ_ZOOM:
+            if (s->builder)
+            {
+                const int size = cmd->delta > 0 ? s->config.window_size * 2
+                                                : s->config.window_size / 2;
+
+                // Built in the background; the display carries on meanwhile.
+                if (size >= ZOOM_MIN_WINDOW && size <= ZOOM_MAX_WINDOW && size % 2 == 0)
+                {
+                    s->config.window_size = size;
+                    analysis_builder_request(s->builder, &s->config);
+                }
+            }
+        break;
+    }
+
+    return 1;
+}
+
+// Takes the latest size of every window the event thread saw resized, with
+// the first window's context current. A minimised window reports 0x0, which
+// no buffer can be made at, so it keeps the size it had.
+static void
+apply_resizes (struct vsp_state *s, struct vsp_view *views, int num_views)
+{
+    int width, height;
+
+    if (cq_size_take(&s->size, &width, &height))
+    {
+        s->minimised = width <= 0 || height <= 0;
+
+        if (!s->minimised)
+        {
+            glViewport(0, 0, width, height);
+            glLineWidth(LINE_WIDTH / INIT_WIDTH * width);
+
+            s->width = width;
+            s->height = height;
+            s->resized = 1;
+        }
+    }
+
+    // Views are told once they're drawn, with their own context current.
+    for (int i = 0; i < num_views; ++i)
+        if (cq_size_take(&views[i].size, &width, &height) && width > 0 && height > 0)
+        {
+            views[i].width = width;
+            views[i].height = height;
+            views[i].resized = 1;
+        }
+}
+
+// Everything the frame loop runs on, set up by main(). With a window, the loop
+// runs on a thread of its own, which owns the contexts; the main thread is
+// left to GLFW's events, and hands what they ask for over through `commands`.
+struct render_loop
+{
+    const struct vsp_options *opts;
+    struct vsp_state *state;
+
+    GLFWwindow *window;
+    struct headless_context *hc;
+    struct vsp_view *views;
+    int num_views;
+
+    struct pipewire_backend *pwb;
+    struct pw_thread_loop *loop;
+    // Swapped for a rebuilt one as the window is zoomed.
+    struct analysis *an;
+    FILE *events;
+    // NULL if not exporting.
+    struct video_exporter *ve;
+
+    struct polygon_renderer *pr;
+    struct level_renderer *levels;
+    struct strip_renderer *chroma_strip;
+    struct marker_renderer *pitch_marker;
+    struct waveform_renderer *scope_trace;
+    struct band_renderer *bands;
+    struct waterfall_renderer *waterfall;
+    struct gpu_fft *gf;
+    struct gpu_timer *frame_timer;
+    struct aa_pass *aa;
+    // Still timing modes for --aa=auto.
+    int aa_probing;
+
+    struct command_queue *commands;
+    // Set by the event thread once a window is closed.
+    atomic_bool stop;
+
+    // The first window's title, as the render thread last wrote it; pending
+    // until the event thread has set it.
+    pthread_mutex_t title_lock;
+    char title[128];
+    bool title_pending;
+};
+
+static void *
+render_loop (void *arg)
+{
+    struct render_loop *l = arg;
+    const struct vsp_options *opts = l->opts;
+    struct vsp_state *state = l->state;
+    GLFWwindow *window = l->window;
+    struct headless_context *hc = l->hc;
+    struct vsp_view *views = l->views;
+    const int num_views = l->num_views;
+    struct pipewire_backend *pwb = l->pwb;
+    struct pw_thread_loop *loop = l->loop;
+    struct analysis *an = l->an;
+    struct loudness_meter *meter = state->meter;
+    FILE *events = l->events;
+    struct video_exporter *ve = l->ve;
+    struct polygon_renderer *pr = l->pr;
+    struct level_renderer *levels = l->levels;
+    struct strip_renderer *chroma_strip = l->chroma_strip;
+    struct marker_renderer *pitch_marker = l->pitch_marker;
+    struct waveform_renderer *scope_trace = l->scope_trace;
+    struct band_renderer *bands = l->bands;
+    struct waterfall_renderer *waterfall = l->waterfall;
+    struct gpu_fft *gf = l->gf;
+    struct gpu_timer *frame_timer = l->frame_timer;
+    struct aa_pass *aa = l->aa;
+    int aa_probing = l->aa_probing;
+
+    const float X_STEP = 2.0 * (1.0 - MARGIN_VW) / opts->num_points;
+    uint64_t tracked_pos = 0;
+    unsigned meter_updates = 0;
+    int title_dirty = 0;
+    double title_time = 0.0;
+    double gpu_time_time = 0.0;
+    double aa_probe_time = 0.0;
+    int first_frame = 1;
+
+    // Paces --headless, which has no vsync to wait on.
+    double next_frame = now();
+
+    if (window)
+        glfwMakeContextCurrent(window);
+
+    while (!quit && !atomic_load_explicit(&l->stop, memory_order_acquire))
+    {
+        struct cq_command cmd;
+        while (cq_pop(l->commands, &cmd))
+            title_dirty |= apply_command(state, views, &cmd);
+        apply_resizes(state, views, num_views);
+
+        // New loudness readings come in every 100 ms; pitch ones every hop, which
+        // is more often than a title is worth rewriting.
+        if (state->meter && atomic_load_explicit(&meter->updates, memory_order_acquire) != meter_updates)
+        {
+            meter_updates = atomic_load_explicit(&meter->updates, memory_order_relaxed);
+            title_dirty = 1;
+        }
+
+        // Titles can only be set on the event thread; it's woken up to do so.
+        if (window && title_dirty && now() - title_time >= 0.1)
+        {
+            pthread_mutex_lock(&l->title_lock);
+            format_title(l->title, sizeof l->title, state);
+            l->title_pending = true;
+            pthread_mutex_unlock(&l->title_lock);
+            glfwPostEmptyEvent();
+
+            title_time = now();
+            title_dirty = 0;
+        }
+
+        // What the windows show between them, and so what has to be uploaded.
+        int scope_shown = state->scope, spectrum_shown = !state->scope;
+        for (int i = 0; i < num_views; ++i)
+        {
+            scope_shown |= views[i].scope;
+            spectrum_shown |= !views[i].scope;
+        }
+
+        struct analysis *next = NULL;
+
+        pw_thread_loop_lock(loop);
+        uint64_t pos = pipewire_backend_capture(pwb, an->sa->sample_win, an->config.window_size);
+
+        // A rebuilt analysis is only swapped in as a full hop comes in, so the
+        // trackers never see one of each size.
+        if (pos - tracked_pos >= (uint64_t)an->config.window_size / 2 && state->builder &&
+            (next = analysis_builder_take(state->builder)))
+            pos = pipewire_backend_capture(pwb, next->sa->sample_win, next->config.window_size);
+        pw_thread_loop_unlock(loop);
+
+        if (next)
+        {
+            analysis_builder_retire(state->builder, an);
+            an = next;
+
+            state->pitch = an->pd;
+
+            if (opts->gpu_bands)
+#ifdef VSP_FIXED_POINT
+                br_resize(bands, (const GLint*)an->sa->ranges, an->sa->fft_size, 2.0 / 32768);
+#else
+                br_resize(bands, (const GLint*)an->sa->ranges, an->sa->fft_size,
+                          2.0 / an->config.window_size);
+#endif
+        }
+
+        // Whole hops that came in since the trackers last ran.
+        const uint64_t hop = an->config.window_size / 2;
+        const uint64_t hops = (pos - tracked_pos) / hop;
+
+        // The trace is uploaded straight from the captured window, before
+        // sa_process() tapers it in place.
+        if (scope_shown)
+        {
+            const int span = SCOPE_SPAN(an->config.window_size);
+            const int start = scope_trigger(an->sa->sample_win, an->config.window_size, span);
+
+            wr_upload(scope_trace, &an->sa->sample_win[start], span);
+        }
+
+        // With the bands done on the GPU, the CPU stops at the FFT; with the FFT
+        // there too, the CPU only transforms new hops, and only for the trackers.
+        if (opts->gpu_fft)
+        {
+            if (spectrum_shown)
+                gpu_fft_process(gf, an->sa->sample_win);
+
+            if (hops && (events || opts->chroma || opts->pitch))
+                sa_transform(an->sa);
+        }
+        else if (opts->gpu_bands)
+            sa_transform(an->sa);
+        else
+            sa_process(an->sa, state->tau);
+
+        // Onsets, chroma and pitch are tracked per hop, not per frame; reuse the
+        // bins once a full one has come in, and own up to the ones that went by.
+        if (hops)
+        {
+            if (events)
+            {
+                const int missed = hops - 1 < INT_MAX ? hops - 1 : INT_MAX;
+                struct onset_event ev[ONSET_MAX_EVENTS];
+
+                const int n = onset_process(an->od, an->sa->freq_bins, (double)pos / opts->sample_rate,
+                                            missed, ev);
+                write_events(events, ev, n);
+            }
+
+            if (opts->chroma)
+                chroma_process(an->ca, an->sa->freq_bins, state->tau);
+
+            if (opts->pitch)
+            {
+                const float previous = an->pd->frequency;
+
+                pitch_process(an->pd, an->sa->sample_win, an->sa->freq_bins);
+                title_dirty |= an->pd->frequency != previous;
+            }
+
+            tracked_pos += hops * hop;
+        }
+
+        if (state->resized)
+        {
+            const float line_width = LINE_WIDTH / INIT_WIDTH * state->width;
+
+            if (opts->aa_lines && opts->gpu_bands)
+                br_set_line(bands, line_width, state->width, state->height);
+            else if (opts->aa_lines)
+                lr_set_line(levels, line_width, state->width, state->height);
+
+            aa_resize(aa, state->width, state->height);
+            state->resized = 0;
+        }
+
+        // Everything is drawn from here on, after the analysis, so that the
+        // stages don't take in the GPU waiting on the CPU.
+        const int timing = opts->gpu_time || aa_probing;
+
+        if (timing)
+            gt_begin(frame_timer);
+
+        aa_begin(aa);
+
+        if (timing)
+            gt_mark(frame_timer);
+
+        // Uploaded once for all the windows, whichever of them shows it.
+        if (spectrum_shown && opts->gpu_bands)
+            br_update(bands, an->sa->freq_bins, state->tau);
+        else if (spectrum_shown && opts->vertex_pull)
+            lr_upload(levels, an->sa->sm_freqs);
+
+        // A row a hop, as the trackers run; the GPU bands never leave the GPU for it.
+        if (hops && spectrum_shown && opts->waterfall)
+        {
+            if (opts->gpu_bands)
+                wf_push_from(waterfall, br_levels_buffer(bands));
+            else
+                wf_push(waterfall, an->sa->sm_freqs);
+        }
+
+        if (!state->scope && opts->waterfall)
+            wf_draw(waterfall, db_rms_to_power(state->gain));
+
+        if (state->scope)
+        {
+            wr_draw(scope_trace, powf(10, (state->gain - INIT_GAIN) / 20));
+        } else if (opts->gpu_bands)
+        {
+            br_draw(bands, db_rms_to_power(state->gain));
+        } else if (opts->vertex_pull)
+        {
+            lr_draw(levels, db_rms_to_power(state->gain));
+        } else
+        {
+            const float gain = db_rms_to_power(state->gain);
+            const sa_level *sm_freqs = an->sa->sm_freqs;
+            struct vertex *vertices = pr_map(pr);
+
+            float sign = 1.0;
+
+            // Smoothing operation
+            for(int i = 1; i < opts->num_points-1; ++i)
+            {
+                float pv = SA_LEVEL_TO_FLOAT(sm_freqs[i-1]) * 0.225
+                         + SA_LEVEL_TO_FLOAT(sm_freqs[i]) * 0.56
+                         + SA_LEVEL_TO_FLOAT(sm_freqs[i+1]) * 0.225;
+                vertices[i].y = sign * gain * pv;
+
+                // Flipping sign creates the characteristic saw pattern.
+                sign = -sign;
+            }
+
+            pr_draw(pr);
+        }
+
+        if (timing)
+            gt_mark(frame_timer);
+
+        if (!state->scope && opts->pitch && an->pd->frequency > 0.0)
+            mr_draw(pitch_marker, -1.0 + MARGIN_VW + X_STEP * sa_point_of(an->sa, an->pd->frequency));
+
+        if (opts->chroma)
+            sr_draw(chroma_strip, an->ca->chroma);
+
+        if (timing)
+            gt_mark(frame_timer);
+
+        aa_end(aa);
+
+        if (timing)
+            gt_mark(frame_timer);
+
+        if (ve)
+        {
+            ve_capture(ve, hc->fbo);
+
+            if (ve_failed(ve))
+            {
+                fputs("Video export failed to write; stopping :(\n", stderr);
+                break;
+            }
+        }
+
+        if (timing)
+            gt_mark(frame_timer);
+
+        if (window)
+            glfwSwapBuffers(window);
+        else
+            glFlush();
+
+        // The other windows are a stage of their own, so that their contexts'
+        // work doesn't land in the swap.
+        if (timing)
+            gt_mark(frame_timer);
+
+        if (first_frame)
+        {
+            trace("first frame");
+            first_frame = 0;
+        }
+
+        if (num_views)
+        {
+            const int marked = opts->pitch && an->pd->frequency > 0.0;
+            const float marker_x = marked ? -1.0 + MARGIN_VW + X_STEP * sa_point_of(an->sa, an->pd->frequency)
+                                          : 0.0;
+            struct view_frame frame = {
+                .levels_texture = opts->gpu_bands ? br_levels(bands) : lr_levels(levels),
+                .scope_trace = scope_trace,
+                .gain = state->gain,
+                .marker_x = marked ? &marker_x : NULL,
+                .chroma = opts->chroma ? an->ca->chroma : NULL,
+                .waterfall = opts->waterfall ? waterfall : NULL,
+                .aa_mode = aa->mode,
+                .published = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0),
+            };
+            // The views' contexts wait on it; it has to be on its way first.
+            glFlush();
+
+            for (int i = 0; i < num_views; ++i)
+                draw_view(&views[i], &frame, opts);
+
+            glfwMakeContextCurrent(window);
+            glDeleteSync(frame.published);
+        }
+
+        if (timing)
+            gt_end(frame_timer);
+
+        // Minimised, the frames are too cheap to judge by; the period starts
+        // over once the window is back.
+        if (aa_probing && state->minimised)
+        {
+            gt_reset(frame_timer);
+            aa_probe_time = now();
+        } else if (aa_probing && now() - aa_probe_time >= AA_PROBE_PERIOD)
+        {
+            const double ms = gt_mean(frame_timer, 0, AA_STAGES);
+
+            // The first period also takes in startup, so it isn't judged.
+            if (ms >= 0.0 && aa_probe_time > 0.0)
+            {
+                if (opts->gpu_time)
+                    fprintf(stderr, "Anti-aliasing: %.3f ms of GPU time from clear to resolve with %s\n",
+                            ms, AA_NAMES[aa->mode]);
+
+                if (ms > AA_BUDGET_MS && aa->mode > AA_OFF)
+                {
+                    enum aa_mode mode = aa->mode - 1;
+
+                    aa_deinit(aa);
+                    while (aa_init(aa, mode, hc->fbo, state->width, state->height) < 0)
+                        mode -= 1;
+
+                    // Frames still in flight were drawn in the old mode.
+                    gt_reset(frame_timer);
+                } else
+                {
+                    aa_probing = 0;
+                    if (opts->gpu_time)
+                        fprintf(stderr, "Anti-aliasing: settled on %s\n", AA_NAMES[aa->mode]);
+                    else
+                        gt_deinit(frame_timer);
+                }
+            }
+
+            aa_probe_time = now();
+        }
+
+        if (opts->gpu_time && now() - gpu_time_time >= GPU_TIME_PERIOD)
+        {
+            fprintf(stderr, "With %s, %s:\n",
+                    opts->aa_lines ? "anti-aliased lines" : "GL lines", AA_NAMES[aa->mode]);
+            gt_report(frame_timer, stderr);
+
+            gpu_time_time = now();
+            title_dirty = 1;
+        }
+
+        // Frames that fall behind are dropped from the schedule, rather than
+        // rushed through to catch up.
+        if (!window)
+        {
+            next_frame += 1.0 / HEADLESS_FPS;
+            const double ahead = next_frame - now();
+
+            if (ahead > 0.0)
+                nanosleep(&(struct timespec) { 0, ahead * 1e9 }, NULL);
+            else
+                next_frame = now();
+        }
+    }
+
+    l->an = an;
+    l->aa_probing = aa_probing;
+
+    // Hands the context back, and gets the event thread out of its wait
+    // should the loop have ended first.
+    if (window)
+    {
+        glfwMakeContextCurrent(NULL);
+        glfwSetWindowShouldClose(window, GLFW_TRUE);
+        glfwPostEmptyEvent();
+    }
+
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    GLFWwindow *window = NULL;
+    struct headless_context hc = { 0 };
+    // Either of the two is up, with the renderers on it.
+    int rendering = 0;
+
+    struct polygon_renderer pr;
+    struct level_renderer levels;
+    struct strip_renderer chroma_strip;
+    struct marker_renderer pitch_marker;
+    struct waveform_renderer scope_trace;
+    struct band_renderer bands;
+    struct waterfall_renderer waterfall;
+    struct gpu_fft gf;
+    struct gpu_timer frame_timer;
+    struct aa_pass aa;
+    // Still timing modes for --aa=auto.
+    int aa_probing = 0;
+    struct pipewire_backend pwb;
+    struct pw_thread_loop *loop;
+    struct pw_setup pws = { .pwb = &pwb };
+    // The windows past the first; see --windows.
+    struct vsp_view *views = NULL;
+    int num_views = 0;
+    pthread_t pw_thread;
+    // PipeWire is still being set up on pw_thread.
+    int pw_pending = 0;
+    struct command_queue commands;
+    struct render_loop rl;
+    pthread_t render_thread;
+
+    int ret;
+
+    struct analysis *an = NULL;
+    struct analysis_builder builder;
+    struct loudness_meter meter;
+    FILE *events = NULL;
+    FILE *export = NULL;
+    struct video_exporter ve;
+    int exporting = 0;
+    struct vertex *points = NULL;
+    struct vsp_options opts;
+
+    struct vsp_state state = {
+        .gain = INIT_GAIN,
+        .tau = INIT_SMOOTHING_FACTOR,
+        .commands = &commands,
+    };
+
+    startup_time = now();
+    cq_init(&commands);
+    cq_size_init(&state.size);
+
+    ret = parse_options(argc, argv, &opts);
+    if (ret != 0)
+        return ret < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+
+    tracing = opts.startup_trace;
+    trace("options parsed");
+
+    if (opts.render_input)
+        return render_file(&opts) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    if (opts.batch_input)
+    {
+        ret = batch_spectrogram(opts.batch_input,
+                                opts.batch_output,
+                                opts.window_size,
+                                opts.num_points,
+                                opts.sample_rate,
+                                opts.jobs);
+
+        return ret == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+
+    // The ring holds the largest window zooming can get to.
+    pws.ring_size = opts.window_size > ZOOM_MAX_WINDOW ? opts.window_size : ZOOM_MAX_WINDOW;
+    pws.hop_size = opts.window_size / 2;
+    pws.sample_rate = opts.sample_rate;
+
+    pw_pending = pthread_create(&pw_thread, NULL, pw_setup_run, &pws) == 0;
+    if (!pw_pending)
+        pw_setup_run(&pws);
+
+    // GLFW won't even initialise without a display server.
+    if (!opts.headless)
+    {
+        glfwInit();
+        trace("GLFW initialised");
+
+        glfwSetErrorCallback(error_callback);
+        // Compute shaders need 4.3; everything else gets by with 3.3.
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, opts.gpu_fft ? 4 : 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+        // Anti-aliasing is done in buffers of our own; see aa_init().
+        glfwWindowHint(GLFW_SAMPLES, 0);
+    } else
+    {
+        struct sigaction sa = { .sa_handler = quit_handler };
+        sigaction(SIGINT, &sa, NULL);
+        sigaction(SIGTERM, &sa, NULL);
+    }
+
+    if (opts.events)
+    {
+        events = strcmp(opts.events, "-") == 0 ? stdout : fopen(opts.events, "w");
+        if (!events)
+        {
+            perror(opts.events);
+            goto error;
+        }
+
+        // Whoever reads these wants them as they happen.
+        setvbuf(events, NULL, _IOLBF, 0);
+    }
+
+    if (opts.export_path)
+    {
+        export = strcmp(opts.export_path, "-") == 0 ? stdout : fopen(opts.export_path, "wb");
+        if (!export)
+        {
+            perror(opts.export_path);
+            goto error;
+        }
+
+        // A reader going away should fail a write, not kill us.
+        signal(SIGPIPE, SIG_IGN);
+    }
+
+    // All analysis state shares one arena.
+    state.config = (struct analysis_config) {
+        .window_size = opts.window_size,
+        .num_points = opts.num_points,
+        .sample_rate = opts.sample_rate,
+        .huge_pages = opts.huge_pages,
+        .onsets = events != NULL,
+        .chroma = opts.chroma,
+        .pitch = opts.pitch,
+    };
+
+    an = analysis_create(&state.config);
+    points = calloc(opts.num_points, sizeof(struct vertex));
+    if (!an || !points)
+    {
+        fputs("Spectrum analyzer initialisation failed :(\n", stderr);
+        goto error;
+    }
+
+    fprintf(stderr, "Analysis arena: %zu bytes (%zu mapped, %s pages)\n",
+            an->arena->used, an->arena->mapped, an->arena->huge_pages ? "huge" : "normal");
+    trace("analysis ready");
+
+    if (opts.loudness)
+    {
+        loudness_init(&meter, opts.sample_rate);
+        state.meter = &meter;
+    }
+
+    state.pitch = an->pd;
+
+    state.scope = opts.scope;
+
+    if (opts.headless)
+    {
+        ret = hc_init(&hc, opts.gpu_fft ? 4 : 3, 3, opts.width, opts.height);
+        if (ret != 0 && opts.gpu_fft)
+        {
+            fputs("No OpenGL 4.3 context; the FFT stays on the CPU :(\n", stderr);
+            opts.gpu_fft = 0;
+
+            ret = hc_init(&hc, 3, 3, opts.width, opts.height);
+        }
+        if (ret != 0)
+        {
+            fputs("Headless OpenGL context creation failed :(\n", stderr);
+            goto error;
+        }
+        trace("headless context created, GL loaded");
+
+        state.width = hc.width;
+        state.height = hc.height;
+    } else
+    {
+        window = glfwCreateWindow(INIT_WIDTH, INIT_HEIGHT, "vsp", NULL, NULL);
+        if (!window && opts.gpu_fft)
+        {
+            fputs("No OpenGL 4.3 context; the FFT stays on the CPU :(\n", stderr);
+            opts.gpu_fft = 0;
+
+            glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+            window = glfwCreateWindow(INIT_WIDTH, INIT_HEIGHT, "vsp", NULL, NULL);
+        }
+        if (!window)
+            goto error;
+        trace("window created");
+
+        glfwSetWindowUserPointer(window, &state);
+        update_window_title(window, &state);
+
+        glfwSetKeyCallback(window, key_callback);
+        glfwSetFramebufferSizeCallback(window, resize_callback);
+        glfwMakeContextCurrent(window); // Set the OpenGL context.
+        glfwSwapInterval(1); // Enable VSync.
+        gladLoadGL(glfwGetProcAddress);
+        trace("GL loaded");
+
+        glfwGetFramebufferSize(window, &state.width, &state.height);
+    }
+
+    init_program_cache();
+    rendering = 1;
+
+    // Generate x-coords; do it here because if it were to be done in the hot-loop,
+    // it would be a waste of CPU cycles. They go into every copy of the vertices
+    // the renderer keeps, and only the y-coords are written from then on.
+    place_points(points, opts.num_points);
+    pr_init(&pr, points, opts.num_points);
+#ifdef VSP_FIXED_POINT
+    wr_init(&scope_trace, GL_SHORT, MARGIN_VW);
+#else
+    wr_init(&scope_trace, GL_FLOAT, MARGIN_VW);
+#endif
+
+    if (opts.gpu_fft)
+    {
+#ifdef VSP_FIXED_POINT
+        ret = gpu_fft_init(&gf, opts.window_size, GL_R16I);
+#else
+        ret = gpu_fft_init(&gf, opts.window_size, GL_R32F);
+#endif
+        // Nothing is captured yet, so the analyzer is free to compare against.
+        if (ret == 0)
+        {
+            const float error = gpu_fft_check(&gf, an->sa);
+            double cpu_us, gpu_us;
+
+            gpu_fft_benchmark(&gf, an->sa, GPU_FFT_BENCHMARK_RUNS, &cpu_us, &gpu_us);
+            fprintf(stderr, "FFT of %d: %.1f µs on the CPU, %.1f µs on the GPU (%s); deviation %.1e\n",
+                    opts.window_size, cpu_us, gpu_us, gf.shared ? "shared memory" : "multi-pass",
+                    error);
+
+            if (!(error <= GPU_FFT_TOLERANCE))
+            {
+                fputs("GPU FFT disagrees with kissfft; the FFT stays on the CPU :(\n", stderr);
+                ret = -1;
+            }
+        }
+        trace("GPU FFT checked");
+
+        if (ret != 0)
+        {
+            gpu_fft_deinit(&gf);
+            opts.gpu_fft = 0;
+        }
+    }
+
+    if (opts.gpu_bands)
+    {
+        // Same scaling as sa_reduce(); the Q15 transform has the 1/N built in,
+        // the GPU one works in unscaled floats whatever the samples are.
+        if (opts.gpu_fft)
+            ret = br_init(&bands, (const GLint*)an->sa->ranges, opts.num_points, an->sa->fft_size,
+                          GL_RG32F, 2.0 / opts.window_size, MARGIN_VW, gf.bins_buffer, opts.aa_lines);
+        else
+#ifdef VSP_FIXED_POINT
+            ret = br_init(&bands, (const GLint*)an->sa->ranges, opts.num_points, an->sa->fft_size,
+                          GL_RG16I, 2.0 / 32768, MARGIN_VW, 0, opts.aa_lines);
+#else
+            ret = br_init(&bands, (const GLint*)an->sa->ranges, opts.num_points, an->sa->fft_size,
+                          GL_RG32F, 2.0 / opts.window_size, MARGIN_VW, 0, opts.aa_lines);
+#endif
+        if (ret != 0)
+        {
+            fputs("GPU band renderer initialisation failed :(\n", stderr);
+            opts.gpu_bands = 0;
+        }
+    }
+    // The GPU bands draw the same way already; this only replaces the CPU's vertices.
+    opts.vertex_pull = opts.vertex_pull && !opts.gpu_bands;
+    if (opts.vertex_pull)
+#ifdef VSP_FIXED_POINT
+        lr_init(&levels, opts.num_points, GL_R32I, 1.0 / 32768, MARGIN_VW, opts.aa_lines);
+#else
+        lr_init(&levels, opts.num_points, GL_R32F, 1.0, MARGIN_VW, opts.aa_lines);
+#endif
+    if (opts.chroma)
+        sr_init(&chroma_strip, CHROMA_CLASSES, 2.0 * CHROMA_STRIP_VH);
+    if (opts.pitch)
+        mr_init(&pitch_marker);
+    if (opts.waterfall)
+    {
+        // Rows are pushed from wherever the levels are drawn from.
+#ifdef VSP_FIXED_POINT
+        if (!opts.gpu_bands)
+            ret = wf_init(&waterfall, opts.num_points, opts.waterfall, GL_R32I, 1.0 / 32768, MARGIN_VW);
+        else
+#endif
+            ret = wf_init(&waterfall, opts.num_points, opts.waterfall, GL_R32F, 1.0, MARGIN_VW);
+        if (ret != 0)
+        {
+            fputs("Waterfall initialisation failed; it's off :(\n", stderr);
+            opts.waterfall = 0;
+        }
+    }
+    glLineWidth(LINE_WIDTH / INIT_WIDTH * state.width);
+    state.resized = 1;
+
+    // Auto starts at the top, and steps down from there as frames come in
+    // over budget; either way, it steps down past modes the GPU can't do.
+    aa_probing = opts.aa == AA_AUTO;
+    enum aa_mode aa_mode = aa_probing ? AA_MSAA8 : opts.aa;
+    while (aa_init(&aa, aa_mode, hc.fbo, state.width, state.height) < 0)
+    {
+        if (!aa_probing)
+            fprintf(stderr, "Anti-aliasing with %s isn't supported; trying %s :(\n",
+                    AA_NAMES[aa_mode], AA_NAMES[aa_mode - 1]);
+        aa_mode -= 1;
+    }
+    if (opts.gpu_time || aa_probing)
+        gt_init(&frame_timer, FRAME_STAGES, NUM_FRAME_STAGES);
+    if (opts.gpu_time)
+        state.timer = &frame_timer;
+
+    if (tracing)
+    {
+        int hits, misses;
+        char phase[64];
+
+        pc_stats(&hits, &misses);
+        snprintf(phase, sizeof phase, "renderers ready (%d programs cached, %d linked)",
+                 hits, misses);
+        trace(phase);
+    }
+
+    if (opts.windows > 1)
+    {
+        views = calloc(opts.windows - 1, sizeof *views);
+        if (!views)
+            goto error;
+
+        num_views = opts.windows - 1;
+        if (open_views(views, num_views, window, &opts, aa.mode) != 0)
+        {
+            fputs("Opening the other windows failed :(\n", stderr);
+            goto error;
+        }
+        trace("other windows opened");
+    }
+
+    if (export)
+    {
+        if (ve_init(&ve, export, opts.export_format, hc.width, hc.height, HEADLESS_FPS, false) != 0)
+        {
+            fputs("Video export initialisation failed :(\n", stderr);
+            goto error;
+        }
+
+        exporting = 1;
+    }
+
+    // The GPU FFT is built for one size; everything else can be zoomed.
+    if (!opts.gpu_fft)
+    {
+        if (analysis_builder_start(&builder) == 0)
+            state.builder = &builder;
+        else
+            fputs("Analysis builder failed to start; zooming is off :(\n", stderr);
+    }
+
+    if (pw_pending)
+    {
+        pthread_join(pw_thread, NULL);
+        pw_pending = 0;
+    }
+    trace("PipeWire ready");
+
+    loop = pws.loop;
+    if (pws.ret != 0)
+    {
+        fputs("PipeWire backend initialisation failed :(\n", stderr);
+        goto error;
+    }
+
+    pw_thread_loop_lock(loop);
+
+    // Runs on the PipeWire thread; the render loop only reads the results.
+    if (opts.loudness)
+        pwb.state.meter = &meter;
+
+    ret = pipewire_backend_connect(&pwb);
+    if (ret != 0)
+    {
+        pw_thread_loop_unlock(loop);
+        fputs ("PipeWire stream connection failed :(\n", stderr);
+        goto error;
+    }
+
+    pw_thread_loop_unlock(loop);
+    trace("stream connected");
+
+    rl = (struct render_loop) {
+        .opts = &opts,
+        .state = &state,
+        .window = window,
+        .hc = &hc,
+        .views = views,
+        .num_views = num_views,
+        .pwb = &pwb,
+        .loop = loop,
+        .an = an,
+        .events = events,
+        .ve = exporting ? &ve : NULL,
+        .pr = &pr,
+        .levels = &levels,
+        .chroma_strip = &chroma_strip,
+        .pitch_marker = &pitch_marker,
+        .scope_trace = &scope_trace,
+        .bands = &bands,
+        .waterfall = &waterfall,
+        .gf = &gf,
+        .frame_timer = &frame_timer,
+        .aa = &aa,
+        .aa_probing = aa_probing,
+        .commands = &commands,
+        .title_lock = PTHREAD_MUTEX_INITIALIZER,
+    };
+
+    if (window)
+    {
+        // The render thread takes the contexts over; this one only waits on
+        // events, so a live resize or a busy queue never stalls a frame.
+        glfwMakeContextCurrent(NULL);
+        if (pthread_create(&render_thread, NULL, render_loop, &rl) != 0)
+        {
+            glfwMakeContextCurrent(window);
+            fputs("Render thread failed to start :(\n", stderr);
+            goto error;
+        }
+        trace("render thread started");
+
+        while (!glfwWindowShouldClose(window) && !views_closed(views, num_views))
+        {
+            glfwWaitEvents();
+
+            pthread_mutex_lock(&rl.title_lock);
+            if (rl.title_pending)
+            {
+                glfwSetWindowTitle(window, rl.title);
+                rl.title_pending = false;
+            }
+            pthread_mutex_unlock(&rl.title_lock);
+        }
+
+        atomic_store_explicit(&rl.stop, true, memory_order_release);
+        pthread_join(render_thread, NULL);
+        glfwMakeContextCurrent(window);
+    } else
+        render_loop(&rl);
+
+    an = rl.an;
+    aa_probing = rl.aa_probing;
+
+    pw_thread_loop_stop(loop);
+
+error:
+    // The renderer is set up right after the window, with nothing that can fail in between.
+    if (rendering)
+    {
+        if (opts.chroma)
+            sr_deinit(&chroma_strip);
+        if (opts.pitch)
+            mr_deinit(&pitch_marker);
+        if (opts.waterfall)
+            wf_deinit(&waterfall);
+        wr_deinit(&scope_trace);
+        if (opts.gpu_bands)
+            br_deinit(&bands);
+        if (opts.gpu_fft)
+            gpu_fft_deinit(&gf);
+        if (opts.vertex_pull)
+            lr_deinit(&levels);
+        if (opts.gpu_time)
+            gt_report(&frame_timer, stderr);
+        if (opts.gpu_time || aa_probing)
+            gt_deinit(&frame_timer);
+        aa_deinit(&aa);
+        pr_deinit(&pr);
+    }
+    if (exporting)
+    {
+        ve_deinit(&ve);
+        fprintf(stderr, "Exported %lu frames; %lu dropped\n",
+                atomic_load(&ve.written), ve.dropped);
+    }
+    close_views(views, num_views, &opts);
+    free(views);
+    if (window)
+        glfwDestroyWindow(window);
+    hc_deinit(&hc);
+
+    if (state.builder)
+        analysis_builder_stop(state.builder);
+    if (an)
+        analysis_destroy(an);
+    free(points);
+
+    if (events && events != stdout)
+        fclose(events);
+    if (export && export != stdout)
+        fclose(export);
+
+    // Whatever went wrong here, the PipeWire setup still has to finish first.
+    if (pw_pending)
+        pthread_join(pw_thread, NULL);
     pipewire_backend_deinit(&pwb);
-    pw_thread_loop_destroy(loop);
+    pw_thread_loop_destroy(pws.loop);
 
     pw_deinit();
     glfwTerminate();